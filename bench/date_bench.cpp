@@ -0,0 +1,101 @@
+// ========================================
+// DATE_BENCH.CPP - Date Parser Microbenchmark
+// ========================================
+// Compares the previous isValidDate() (three substr() copies, three isNumeric()
+// loops and three stoi() calls per date) with the parser in dateparse.h on a mix
+// of valid and invalid dates, and checks both agree except where the old one
+// let impossible dates through (31-02, 29-02 outside leap years, ...).
+// Also times parseDateTime() on registration stamps ("DD-MM-YYYY HH:MM").
+// Usage: bench-date [iterations]
+
+#include "dateparse.h"
+#include "utils.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+// The parser is usable at compile time
+static_assert(parseDate("29-02-2024") != 0, "2024 is a leap year");
+static_assert(parseDate("29-02-2025") == 0, "2025 is not a leap year");
+static_assert(parseDate("31-04-2026") == 0, "April has 30 days");
+static_assert(parseDate("1x-01-2026") == 0, "not a digit");
+static_assert(parseDateTime("15-03-2025 23:59") != INVALID_DATETIME &&
+              parseDateTime("15-03-2025 24:00") == INVALID_DATETIME, "hours run 0-23");
+static_assert(parseDateTime("01-01-1970 00:00") == 0, "the epoch is a real time");
+static_assert(daysFromCivil(1970, 1, 1) == 0 && daysFromCivil(2000, 3, 1) == 11017, "day numbers");
+
+// isValidDate() as it was before dateparse.h
+bool legacyIsValidDate(const string& date) {
+    if (date.length() != 10) return false;
+    if (date[2] != '-' || date[5] != '-') return false;
+
+    string day = date.substr(0, 2);
+    string month = date.substr(3, 2);
+    string year = date.substr(6, 4);
+    if (!isNumeric(day) || !isNumeric(month) || !isNumeric(year)) return false;
+
+    int d = stoi(day);
+    int m = stoi(month);
+    int y = stoi(year);
+    if (m < 1 || m > 12) return false;
+    if (d < 1 || d > 31) return false;
+    if (y < 2025) return false;
+    return true;
+}
+
+// Run 'check' over every input 'iterations' times; returns nanoseconds per call
+template <typename Check>
+double timeCalls(const vector<string>& inputs, int iterations, long& accepted, Check check) {
+    accepted = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (const auto& input : inputs) accepted += check(input);
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return ns / ((double)iterations * inputs.size());
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc >= 2 ? stoi(argv[1]) : 20000;
+
+    // Every day of 2025-2028 plus some malformed and impossible inputs
+    vector<string> dates;
+    for (int32_t day = dayNumber("01-01-2025"); day <= dayNumber("31-12-2028"); day++) {
+        dates.push_back(formatDayNumber(day));
+    }
+    const vector<string> extra = {"31-02-2026", "29-02-2027", "31-04-2026", "00-01-2026", "15-13-2026",
+                                  "1-1-2026", "ab-cd-efgh", "15/03/2025", "15-03-2024", ""};
+    size_t impossible = 3;    // The first three pass the old check but are not real dates
+    dates.insert(dates.end(), extra.begin(), extra.end());
+
+    vector<string> stamps;
+    for (const auto& date : dates) stamps.push_back(date + " 14:30");
+
+    cout << "=== DATE PARSING ===" << endl;
+    cout << dates.size() << " dates x " << iterations << " iterations" << endl;
+    cout << left << setw(32) << "Function" << setw(12) << "ns/call" << "Accepted" << endl;
+
+    long legacyAccepted, newAccepted, stampsAccepted;
+    double legacy = timeCalls(dates, iterations, legacyAccepted,
+                              [](const string& date) { return legacyIsValidDate(date); });
+    double fast = timeCalls(dates, iterations, newAccepted, [](const string& date) { return isValidDate(date); });
+    double stamp = timeCalls(stamps, iterations, stampsAccepted,
+                             [](const string& stamp) { return parseDateTime(stamp) != INVALID_DATETIME; });
+
+    cout << fixed << setprecision(1);
+    cout << setw(32) << "isValidDate (substr + stoi)" << setw(12) << legacy << legacyAccepted / iterations << endl;
+    cout << setw(32) << "isValidDate (dateparse.h)" << setw(12) << fast << newAccepted / iterations << endl;
+    cout << setw(32) << "parseDateTime" << setw(12) << stamp << stampsAccepted / iterations << endl;
+    cout << "Speedup: " << legacy / fast << "x" << endl;
+
+    // Same answers, except the impossible dates the old check accepted
+    if (legacyAccepted / iterations != newAccepted / iterations + (long)impossible) {
+        cout << "Error: the parsers disagree!" << endl;
+        return 1;
+    }
+    return 0;
+}
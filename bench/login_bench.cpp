@@ -0,0 +1,66 @@
+// ========================================
+// LOGIN_BENCH.CPP - Login Throughput Benchmark
+// ========================================
+// Measures how many password verifications per second the verifier pool sustains
+// at different PBKDF2 costs, i.e. how fast a burst of logins can be served.
+// Usage: bench-login [cost ...]   (default: 1000 5000 20000 100000)
+
+#include "password.h"
+#include "verifierpool.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+// Verify 'logins' passwords (a mix of right and wrong ones) through the pool
+// Returns: logins per second
+double measureLogins(VerifierPool& pool, int cost, size_t logins) {
+    setPasswordCost(cost);
+    string stored = hashPassword("correct horse");
+
+    auto start = chrono::steady_clock::now();
+    vector<future<bool>> results;
+    results.reserve(logins);
+    for (size_t i = 0; i < logins; i++) {
+        results.push_back(pool.verify(stored, i % 4 == 0 ? "wrong guess" : "correct horse"));
+    }
+
+    size_t accepted = 0;
+    for (auto& result : results) {
+        if (result.get()) accepted++;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (accepted != logins - (logins + 3) / 4) {
+        cout << "Error: wrong number of accepted logins at cost " << cost << "!" << endl;
+    }
+    return logins / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> costs;
+    for (int i = 1; i < argc; i++) {
+        costs.push_back(stoi(argv[i]));
+    }
+    if (costs.empty()) {
+        costs = {1000, 5000, PASSWORD_DEFAULT_COST, 100000};
+    }
+
+    VerifierPool pool;
+    cout << "=== LOGIN THROUGHPUT (" << pool.threadCount() << " verifier threads) ===" << endl;
+    cout << left << setw(12) << "Cost" << setw(12) << "Logins" << "Logins/sec" << endl;
+
+    for (int cost : costs) {
+        // Roughly the same amount of hashing work per cost setting
+        size_t perThread = max<size_t>(4, 600000 / cost);
+        size_t logins = perThread * pool.threadCount();
+        double rate = measureLogins(pool, cost, logins);
+        cout << left << setw(12) << cost << setw(12) << logins
+             << fixed << setprecision(1) << rate << endl;
+    }
+    return 0;
+}
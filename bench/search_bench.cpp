@@ -0,0 +1,73 @@
+// ========================================
+// SEARCH_BENCH.CPP - Event Search Benchmark
+// ========================================
+// Builds a catalog of synthetic events and runs the same substring queries two
+// ways: the old scan (toLower() on every name + find()) and the trigram
+// SearchIndex. Both must return the same number of matches; the index should be
+// much faster for selective queries and stay flat as the catalog grows.
+// Usage: bench-search [events] [queries per term]
+
+#include "searchindex.h"
+#include "utils.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+// Time 'rounds' calls of 'query' and return the average in microseconds
+template <typename Query>
+double timeQuery(int rounds, size_t& matches, Query query) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) matches = query();
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    int eventCount = argc >= 2 ? stoi(argv[1]) : 100000;
+    int rounds = argc >= 3 ? stoi(argv[2]) : 50;
+
+    // Names like "Robotics Workshop 4711" - a few common words, unique numbers
+    const vector<string> topics = {"Robotics", "Cultural", "Coding", "Salsa", "Chess", "Drama",
+                                   "Music", "Startup", "Quiz", "Photography"};
+    const vector<string> kinds = {"Workshop", "Night", "Competition", "Meetup", "Fest", "Seminar"};
+    vector<string> names(eventCount);
+    SearchIndex index;
+    for (int i = 0; i < eventCount; i++) {
+        names[i] = topics[i % topics.size()] + " " + kinds[(i / 7) % kinds.size()] + " " + to_string(i);
+        index.add(eventSymbols().intern(names[i]), names[i], "Hall " + to_string(i % 50));
+    }
+
+    cout << "=== EVENT SEARCH ===" << endl;
+    cout << eventCount << " events, " << rounds << " queries per term" << endl;
+    cout << left << setw(16) << "Query" << setw(10) << "Matches" << setw(14) << "Scan (us)"
+         << setw(14) << "Index (us)" << "Speedup" << endl;
+
+    bool mismatch = false;
+    for (string term : {"4711", "salsa night", "quiz", "workshop", "ph"}) {
+        size_t scanMatches = 0, indexMatches = 0;
+        double scan = timeQuery(rounds, scanMatches, [&] {
+            size_t found = 0;
+            string needle = toLower(term);
+            for (const auto& name : names) {
+                if (toLower(name).find(needle) != string::npos) found++;
+            }
+            return found;
+        });
+        double indexed = timeQuery(rounds, indexMatches, [&] {
+            return index.search(term, SEARCH_NAME).size();
+        });
+        if (scanMatches != indexMatches) mismatch = true;
+
+        cout << setw(16) << ("'" + term + "'") << setw(10) << indexMatches << fixed << setprecision(1)
+             << setw(14) << scan << setw(14) << indexed << setprecision(1) << scan / indexed << "x" << endl;
+    }
+
+    if (mismatch) {
+        cout << "Error: index and scan returned different results!" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+// ========================================
+// SEAT_BENCH.CPP - Seat Reservation Stress Test & Benchmark
+// ========================================
+// 1. Stress: many threads race for the last few seats of many events at once;
+//    every event must end exactly full and no thread may get a seat too many.
+// 2. Throughput: reservations/sec when all threads share one event versus when
+//    each thread has its own event (different events should not contend).
+// Usage: bench-seats [threads]
+
+#include "event.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+// Run 'work(threadIndex)' on 'threads' threads, released together; returns seconds
+template <typename Work>
+double runThreads(int threads, Work work) {
+    atomic<bool> go(false);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            while (!go.load()) this_thread::yield();
+            work(t);
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    go = true;
+    for (auto& worker : workers) worker.join();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Stress test: every thread tries to grab more seats than exist, on every event
+// Returns: true if no event was oversold
+bool stressLastSeats(int threads) {
+    const int eventCount = 20000;
+    const int seatsLeft = 8;          // Seats still free in each event
+    const int attemptsPerThread = 4;  // Per event, so threads * 4 attempts race for 8 seats
+
+    vector<Event> events;
+    events.reserve(eventCount);
+    for (int i = 0; i < eventCount; i++) {
+        events.emplace_back("Event " + to_string(i), "01-01-2026", "Hall", 100, 100 - seatsLeft);
+    }
+
+    vector<long> granted(threads, 0);
+    runThreads(threads, [&](int t) {
+        for (int e = 0; e < eventCount; e++) {
+            // Start at a different event per thread, so threads overlap everywhere
+            Event& event = events[(e + t * 7) % eventCount];
+            for (int a = 0; a < attemptsPerThread; a++) {
+                if (event.tryReserveSeat()) granted[t]++;
+            }
+        }
+    });
+
+    long totalGranted = 0;
+    for (long count : granted) totalGranted += count;
+    long oversold = 0;
+    for (const auto& event : events) {
+        oversold += max(0, event.getRegisteredCount() - event.getCapacity());
+    }
+
+    cout << "Stress: " << threads << " threads x " << eventCount << " events, "
+         << seatsLeft << " seats left each, " << threads * attemptsPerThread << " attempts per event" << endl;
+    cout << "  seats granted: " << totalGranted << " (expected " << (long)eventCount * seatsLeft << ")" << endl;
+    cout << "  oversold:      " << oversold << endl;
+    return oversold == 0 && totalGranted == (long)eventCount * seatsLeft;
+}
+
+// One event on cache lines of its own. Adjacent Events in a vector would put the
+// seat counters of different threads on the same line (false sharing), so the
+// "one event per thread" case would still contend
+struct alignas(64) PaddedEvent {
+    Event event;
+    explicit PaddedEvent(const string& name) : event(name, "01-01-2026", "Hall", 1000000000, 0) {}
+};
+
+// Reserve + release as fast as possible; 'shared' = all threads on one event
+double measureThroughput(int threads, bool shared) {
+    const int operations = 2000000;
+    vector<PaddedEvent> events;
+    events.reserve(threads);
+    for (int t = 0; t < threads; t++) {
+        events.emplace_back("Event " + to_string(t));
+    }
+
+    double seconds = runThreads(threads, [&](int t) {
+        Event& event = events[shared ? 0 : t].event;
+        for (int i = 0; i < operations; i++) {
+            event.tryReserveSeat();
+            event.releaseSeat();
+        }
+    });
+    return (2.0 * operations * threads) / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = argc >= 2 ? stoi(argv[1]) : max(4, (int)thread::hardware_concurrency());
+
+    cout << "=== SEAT RESERVATION ===" << endl;
+    bool ok = stressLastSeats(threads);
+
+    cout << left << setw(24) << "Throughput" << "Ops/sec (" << threads << " threads)" << endl;
+    cout << setw(24) << "  one shared event" << fixed << setprecision(0)
+         << measureThroughput(threads, true) << endl;
+    cout << setw(24) << "  one event per thread" << measureThroughput(threads, false) << endl;
+
+    if (!ok) {
+        cout << "Error: seats were oversold!" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// ========================================
+// STORE_BENCH.CPP - Registration Store Scalability Benchmark
+// ========================================
+// Registers distinct students through EventStore::registerStudent (journal, index,
+// seat counter - the same path the server uses) on 1, 2, 4 ... N threads, with the
+// registrations spread over many events. Because the index is sharded by event,
+// throughput should grow with the thread count instead of flattening at one core.
+// Every registration waits until its journal record is on disk; commits in flight
+// together share one flush (group commit), so "Commits/flush" grows with the number
+// of threads and throughput is not capped at one registration per disk flush.
+// A reader thread runs alongside and reports how many event lookups it managed.
+// Each run uses a fresh data folder under /tmp.
+// Usage: bench-store [max threads] [registrations per run]
+
+#include "eventstore.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+const int EVENT_COUNT = 1024;
+
+struct RunResult {
+    double registrationsPerSec;
+    double readsPerSec;
+    double commitsPerFlush;
+    long failed;
+};
+
+// Fresh data folder with EVENT_COUNT roomy events and no registrations
+string makeDataDir() {
+    char dirTemplate[] = "/tmp/store-bench-XXXXXX";
+    string dir = mkdtemp(dirTemplate);
+
+    vector<Event> events;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        events.emplace_back("Event " + to_string(i), "01-01-2026", "Hall", 1000000, 0);
+    }
+    EventStore::writeEventsFile(dir + "/events.txt", events);
+    return dir;
+}
+
+// One run: 'threads' writers register 'total' students between them
+RunResult runStore(int threads, int total, int run) {
+    string dir = makeDataDir();
+    RunResult result = {0, 0, 0, 0};
+    {
+        EventStore store(dir);
+        store.setCompactionThreshold((size_t)total + 1);    // Measure the hot path only
+        store.refresh();
+
+        // Names are built up front so the timed loop only does store work
+        vector<string> students(total), eventNames(EVENT_COUNT);
+        for (int i = 0; i < total; i++) students[i] = "r" + to_string(run) + "s" + to_string(i);
+        for (int i = 0; i < EVENT_COUNT; i++) eventNames[i] = "Event " + to_string(i);
+
+        atomic<bool> go(false), writersDone(false);
+        atomic<long> failed(0);
+        long reads = 0;
+
+        // Reader: what a LIST / "view events" does, while the writers run
+        thread reader([&] {
+            while (!go.load()) this_thread::yield();
+            int i = 0;
+            while (!writersDone.load()) {
+                auto guard = store.readLock();
+                Event* event = store.findEvent(eventNames[i++ % EVENT_COUNT]);
+                if (event != nullptr && event->getRegisteredCount() >= 0) reads++;
+            }
+        });
+
+        vector<thread> writers;
+        for (int t = 0; t < threads; t++) {
+            writers.emplace_back([&, t] {
+                while (!go.load()) this_thread::yield();
+                for (int i = t; i < total; i += threads) {
+                    if (store.registerStudent(students[i], eventNames[i % EVENT_COUNT],
+                                              "01-01-2026 10:00") != REGISTRATION_OK) {
+                        failed++;
+                    }
+                }
+            });
+        }
+
+        uint64_t flushesBefore = store.getSyncCount();
+        auto start = chrono::steady_clock::now();
+        go = true;
+        for (auto& writer : writers) writer.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        writersDone = true;
+        reader.join();
+
+        result.registrationsPerSec = total / seconds;
+        result.readsPerSec = reads / seconds;
+        result.commitsPerFlush = (double)total / max<uint64_t>(1, store.getSyncCount() - flushesBefore);
+        result.failed = failed;
+    }
+    system(("rm -rf " + dir).c_str());
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int maxThreads = argc >= 2 ? stoi(argv[1]) : max(16, (int)thread::hardware_concurrency());
+    int total = argc >= 3 ? stoi(argv[2]) : 20000;
+
+    cout << "=== REGISTRATION STORE SCALABILITY ===" << endl;
+    cout << total << " registrations per run over " << EVENT_COUNT << " events, 1 reader thread" << endl;
+    cout << left << setw(10) << "Threads" << setw(20) << "Registrations/sec" << setw(10) << "Speedup"
+         << setw(15) << "Commits/flush" << "Reads/sec" << endl;
+
+    // 1, 2, 4 ... and always finish with exactly maxThreads
+    vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double baseline = 0;
+    long failed = 0;
+    int run = 0;
+    for (int threads : threadCounts) {
+        RunResult result = runStore(threads, total, run++);
+        if (baseline == 0) baseline = result.registrationsPerSec;
+        failed += result.failed;
+
+        cout << setw(10) << threads << fixed << setprecision(0) << setw(20) << result.registrationsPerSec
+             << setprecision(2) << setw(10) << result.registrationsPerSec / baseline
+             << setprecision(1) << setw(15) << result.commitsPerFlush
+             << setprecision(0) << result.readsPerSec << endl;
+    }
+
+    if (failed > 0) {
+        cout << "Error: " << failed << " registrations failed!" << endl;
+        return 1;
+    }
+    return 0;
+}
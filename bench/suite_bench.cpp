@@ -0,0 +1,241 @@
+// ========================================
+// SUITE_BENCH.CPP - Data Layer Benchmark Suite (JSON output)
+// ========================================
+// Times the data-layer hot paths on synthetic datasets of increasing size and
+// prints the results as one JSON document, so runs can be saved and compared over
+// time (make bench writes it to build/bench/results.json).
+//
+// For each dataset size N (registrations) a fresh data folder is written with
+// N/100 events (at least 100) and N/10 students registered for 10 events each,
+// then these operations are timed through the same EventStore calls the menus use:
+//   load            EventStore construction + refresh() (text files -> indexes)
+//   search          searchEvents() on name and venue terms
+//   filter          eventsBetween() over a 7-day window, upcomingEvents(10)
+//   report          buildRegistrationSummary() + buildHourlyRegistrations()
+//   register        registerStudent() of new students (journal + group commit)
+//   unregister      unregisterStudent() of the same students
+//   deleteCascade   deleteEvent() of events holding ~N/E registrations each
+// A "micro" section times the per-line helpers the loaders are built on (split,
+// trim, toLower, isValidDate, splitFields) on the generated events.txt lines.
+//
+// Progress goes to stderr; stdout is only the JSON.
+// Usage: bench-suite [registrations ...]      (default: 1000 10000 100000 1000000)
+
+#include "eventstore.h"
+#include "report.h"
+#include "mappedfile.h"
+#include "utils.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+const int REGISTRATIONS_PER_STUDENT = 10;
+const int REGISTER_OPERATIONS = 1000;    // New registrations timed per dataset (fewer for tiny sets)
+const int DELETE_OPERATIONS = 10;
+const int QUERY_ROUNDS = 200;
+
+typedef chrono::steady_clock Clock;
+
+size_t benchSink;    // Results of the micro benchmarks end up here so the calls are not dropped
+
+// One timed operation: how many calls and how long they took together
+struct Timing {
+    string name;
+    long count;
+    double totalMs;
+};
+
+// Time 'count' calls of body(i)
+template <typename Body>
+Timing timeOperation(const string& name, long count, Body body) {
+    auto start = Clock::now();
+    for (long i = 0; i < count; i++) body(i);
+    double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+    return {name, count, ms};
+}
+
+// {"name": {"count": ..., "totalMs": ..., "usPerOp": ...}, ...}
+string timingsJson(const vector<Timing>& timings, const string& indent) {
+    ostringstream json;
+    json.setf(ios::fixed);
+    json.precision(3);
+    json << "{";
+    for (size_t i = 0; i < timings.size(); i++) {
+        const Timing& t = timings[i];
+        json << (i == 0 ? "\n" : ",\n") << indent << "  \"" << t.name << "\": {\"count\": " << t.count
+             << ", \"totalMs\": " << t.totalMs << ", \"usPerOp\": "
+             << (t.count > 0 ? t.totalMs * 1000.0 / t.count : 0.0) << "}";
+    }
+    json << "\n" << indent << "}";
+    return json.str();
+}
+
+// ==================== DATASETS ====================
+
+struct Dataset {
+    string dir;
+    long registrations;
+    int events;
+    long students;
+};
+
+string eventName(int i) {
+    const char* topics[] = {"Robotics", "Cultural", "Coding", "Salsa", "Chess", "Drama", "Music", "Quiz"};
+    return string(topics[i % 8]) + " Event " + to_string(i);
+}
+
+string studentName(long i) {
+    return "student" + to_string(i);
+}
+
+// Write events.txt and registrations.txt for N registrations into a fresh folder
+// Event i is dated i % 365 days after 01-01-2026; student s registers for events
+// s, s + E/10, s + 2E/10, ... (mod E), so the pairs are distinct and evenly spread
+Dataset makeDataset(long registrations) {
+    char dirTemplate[] = "/tmp/suite-bench-XXXXXX";
+    Dataset data;
+    data.dir = mkdtemp(dirTemplate);
+    data.registrations = registrations;
+    data.events = (int)max(100L, registrations / 100);
+    data.students = max(1L, registrations / REGISTRATIONS_PER_STUDENT);
+
+    int stride = max(1, data.events / REGISTRATIONS_PER_STUDENT);
+    vector<int> counts(data.events, 0);
+    vector<Registration> regs;
+    regs.reserve(registrations);
+    for (long s = 0; s < data.students && (long)regs.size() < registrations; s++) {
+        SymbolId student = userSymbols().intern(studentName(s));
+        for (int k = 0; k < REGISTRATIONS_PER_STUDENT && (long)regs.size() < registrations; k++) {
+            int event = (int)((s + (long)k * stride) % data.events);
+            regs.emplace_back(student, eventSymbols().intern(eventName(event)),
+                              parseTimestamp("01-12-2025 09:00") + (Timestamp)(s % 600));
+            counts[event]++;
+        }
+    }
+
+    // The count column must agree with the registrations, or the load rebuilds it
+    int32_t firstDay = dayNumber("01-01-2026");
+    vector<Event> events;
+    events.reserve(data.events);
+    for (int i = 0; i < data.events; i++) {
+        events.emplace_back(eventName(i), formatDayNumber(firstDay + i % 365), "Hall " + to_string(i % 50),
+                            1000000, counts[i]);
+    }
+    EventStore::writeEventsFile(data.dir + "/events.txt", events);
+    EventStore::writeRegistrationsFile(data.dir + "/registrations.txt", regs);
+    return data;
+}
+
+// ==================== RUNS ====================
+
+// Per-line helpers on the lines of a real events.txt
+vector<Timing> runMicro() {
+    Dataset data = makeDataset(10000);
+    vector<string> lines, dates;
+    forEachLine(data.dir + "/events.txt", [&](string_view line) { lines.emplace_back(line); });
+    for (const auto& line : lines) dates.push_back(line.substr(line.find('|') + 1, 10));
+    system(("rm -rf " + data.dir).c_str());
+
+    const long rounds = 50;
+    long n = rounds * (long)lines.size();
+    size_t sink = 0;
+    vector<Timing> timings;
+    timings.push_back(timeOperation("split", n, [&](long i) { sink += split(lines[i % lines.size()], '|').size(); }));
+    timings.push_back(timeOperation("splitFields", n, [&](long i) {
+        string_view fields[5];
+        sink += splitFields(lines[i % lines.size()], '|', fields, 5);
+    }));
+    timings.push_back(timeOperation("trim", n, [&](long i) { sink += trim(lines[i % lines.size()]).size(); }));
+    timings.push_back(timeOperation("toLower", n, [&](long i) { sink += toLower(lines[i % lines.size()]).size(); }));
+    timings.push_back(timeOperation("isValidDate", n, [&](long i) {
+        sink += isValidDate(dates[i % dates.size()]);
+    }));
+    benchSink = sink;
+    return timings;
+}
+
+// Every operation on one dataset
+vector<Timing> runDataset(const Dataset& data) {
+    vector<Timing> timings;
+    EventStore* store = nullptr;
+
+    timings.push_back(timeOperation("load", 1, [&](long) {
+        store = new EventStore(data.dir);
+        store->refresh();
+    }));
+    store->setCompactionThreshold(SIZE_MAX);    // Time the hot path, not compaction
+
+    const vector<string> terms = {"robotics", "event 4", "hall 7", "salsa event 1", "zzz"};
+    timings.push_back(timeOperation("search", QUERY_ROUNDS, [&](long i) {
+        const string& term = terms[i % terms.size()];
+        store->searchEvents(term, i % 2 == 0 ? SEARCH_NAME : SEARCH_VENUE);
+    }));
+
+    int32_t firstDay = dayNumber("01-01-2026");
+    timings.push_back(timeOperation("filter", QUERY_ROUNDS, [&](long i) {
+        int32_t day = firstDay + (int32_t)(i * 37 % 358);
+        store->eventsBetween(day, day + 6);
+        store->upcomingEvents(10);
+    }));
+
+    timings.push_back(timeOperation("report", 1, [&](long) {
+        buildRegistrationSummary(store->getEvents(), store->getRegistrations());
+        buildHourlyRegistrations(store->getRegistrations());
+    }));
+
+    // New students, so every call takes the full path (no duplicate short-cut)
+    long operations = min<long>(REGISTER_OPERATIONS, max(10L, data.registrations / 10));
+    vector<string> newStudents(operations);
+    for (long i = 0; i < operations; i++) newStudents[i] = "newstudent" + to_string(i);
+    long failed = 0;
+    timings.push_back(timeOperation("register", operations, [&](long i) {
+        failed += store->registerStudent(newStudents[i], eventName((int)(i % data.events)),
+                                         "15-12-2025 10:00") != REGISTRATION_OK;
+    }));
+    timings.push_back(timeOperation("unregister", operations, [&](long i) {
+        failed += store->unregisterStudent(newStudents[i], eventName((int)(i % data.events))) != REGISTRATION_OK;
+    }));
+
+    // Spread over the catalog so every deleted event has its share of registrations
+    timings.push_back(timeOperation("deleteCascade", DELETE_OPERATIONS, [&](long i) {
+        failed += !store->deleteEvent(eventName((int)(i * (data.events / DELETE_OPERATIONS))));
+    }));
+
+    if (failed > 0) cerr << "Warning: " << failed << " operation(s) failed" << endl;
+    delete store;
+    return timings;
+}
+
+int main(int argc, char* argv[]) {
+    vector<long> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(atol(argv[i]));
+    if (sizes.empty()) sizes = {1000, 10000, 100000, 1000000};
+
+    cerr << "Micro benchmarks..." << endl;
+    vector<Timing> micro = runMicro();
+
+    vector<string> datasets;
+    for (long size : sizes) {
+        cerr << "Dataset: " << size << " registrations..." << endl;
+        Dataset data = makeDataset(size);
+        vector<Timing> timings = runDataset(data);
+        system(("rm -rf " + data.dir).c_str());
+
+        datasets.push_back("    {\"registrations\": " + to_string(data.registrations) + ", \"events\": " +
+                           to_string(data.events) + ", \"students\": " + to_string(data.students) +
+                           ",\n     \"operations\": " + timingsJson(timings, "     ") + "}");
+    }
+
+    cout << "{\n  \"benchmark\": \"data-layer\",\n  \"timestamp\": \"" << currentDateTime() << "\",\n";
+    cout << "  \"micro\": " << timingsJson(micro, "  ") << ",\n";
+    cout << "  \"datasets\": [";
+    for (size_t i = 0; i < datasets.size(); i++) cout << (i == 0 ? "\n" : ",\n") << datasets[i];
+    cout << "\n  ]\n}" << endl;
+    return 0;
+}
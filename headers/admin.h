@@ -4,12 +4,19 @@
 #include "user.h"
 #include "event.h"
 #include "registration.h"
+#include "eventstore.h"
+#include "report.h"
+#include "userdirectory.h"
+#include "importer.h"
+#include "password.h"
+#include "verifierpool.h"
 #include "utils.h"
 #include <vector>
 #include <fstream>
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 using namespace std;
 
@@ -26,17 +33,13 @@ public:
     // Virtual method implementation
     string getUserType() override;
     
-    // File I/O Operations
-    vector<Event> loadEventsFromFile();
-    bool saveEventsToFile(const vector<Event>& events);
-    vector<Registration> loadRegistrationsFromFile();
-    bool saveRegistrationsToFile(const vector<Registration>& registrations);
-    
     // Event Management
     void manageEvents();
     void addNewEvent();
     void editEvent();
     void deleteEvent();
+    void importEvents();
+    void enrollClass();
     
     // View and Report Features
     void viewAllEvents();
@@ -47,6 +50,8 @@ public:
     void manageUsers();
     void addNewStudent();
     void viewAllUsers();
+    void migratePasswords();
+    void importStudents();
 };
 
 #endif // ADMIN_H
@@ -0,0 +1,37 @@
+#ifndef CLI_H
+#define CLI_H
+
+#include <string>
+
+using namespace std;
+
+// ==================== COMMAND LINE MODE ====================
+
+// Non-interactive subcommands, so the system can be driven from scripts, cron jobs
+// and load generators instead of keystrokes piped into the menus:
+//   list-events [--json]                           name|date|venue|capacity|registered
+//   search --query <text> [--json]                 events whose name or venue matches
+//   register --user <username> --event <name>
+//   unregister --user <username> --event <name>
+//   enroll --event <name> --users <u1,u2,...>      batch registration (one write)
+//   my-registrations --user <username> [--json]
+//   report summary [--json]                        same numbers as the statistics screen
+//   report participants --event <name> [--json]
+//   import events|students <file.csv>             bulk import (see importer.h)
+//   snapshot enable|disable                        binary snapshot on/off (see snapshot.h)
+//   snapshot to-binary|to-text <in...> <out...>    convert between text and binary files
+//   help
+// Each one calls the same EventStore / UserDirectory / report functions as the
+// Admin and Student menus, prints its result on stdout (plain lines or JSON) and
+// exits with 0 on success or 1 on any error. Errors, usage text and notes go to
+// stderr, so a failed --json command leaves stdout empty. There is no login: whoever can run the
+// program can already edit the data files.
+
+// Is 'name' one of the subcommands above?
+bool isCliCommand(const string& name);
+
+// Run the subcommand in argv[1] with its options
+// Returns: the process exit code
+int runCliCommand(int argc, char* argv[]);
+
+#endif // CLI_H
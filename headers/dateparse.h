@@ -0,0 +1,96 @@
+#ifndef DATEPARSE_H
+#define DATEPARSE_H
+
+#include <string_view>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== DATE PARSING ====================
+
+// Non-allocating parsers for "DD-MM-YYYY" dates and "DD-MM-YYYY HH:MM" timestamps.
+// Every function is constexpr, so dates can be checked at compile time
+// (static_assert(parseDate("29-02-2024") != 0)) as well as at run time.
+//
+// The fast path reads the fixed-position digits straight from the view: each
+// character is turned into (c - '0') and all of them are OR-ed into one "bad
+// digit" mask, so a valid date is checked with a handful of arithmetic steps and
+// no per-field branching, substr() or stoi(). Calendar rules are then applied
+// (month 1-12, day within the month, 29-02 only in leap years).
+
+// Gregorian leap year
+constexpr bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Number of days in a month (month 1-12)
+constexpr int daysInMonth(int year, int month) {
+    constexpr int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+}
+
+// Value of two / four digits at 'pos'; 'bad' gets a bit above 9 set for any non-digit
+constexpr int digits2(string_view str, size_t pos, unsigned& bad) {
+    unsigned a = (unsigned)(unsigned char)str[pos] - '0';
+    unsigned b = (unsigned)(unsigned char)str[pos + 1] - '0';
+    bad |= (a > 9) | (b > 9);
+    return (int)(a * 10 + b);
+}
+
+constexpr int digits4(string_view str, size_t pos, unsigned& bad) {
+    return digits2(str, pos, bad) * 100 + digits2(str, pos + 2, bad);
+}
+
+// Is day-month-year a real calendar date? (year 0-9999)
+constexpr bool isCalendarDate(int day, int month, int year) {
+    return month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month);
+}
+
+// Parse "DD-MM-YYYY" into the packed date layout (year | month 4 bits | day 5 bits)
+// Returns: 0 if the text is malformed or not a real date
+constexpr uint32_t parseDate(string_view date) {
+    if (date.size() != 10 || date[2] != '-' || date[5] != '-') return 0;
+
+    unsigned bad = 0;
+    int day = digits2(date, 0, bad);
+    int month = digits2(date, 3, bad);
+    int year = digits4(date, 6, bad);
+    if (bad != 0 || !isCalendarDate(day, month, year)) return 0;
+
+    return ((uint32_t)year << 9) | ((uint32_t)month << 5) | (uint32_t)day;
+}
+
+// Days from 01-01-1970 to a calendar date (proleptic Gregorian calendar)
+// Counts in 400-year eras starting in March, so the leap day is the last day of
+// the counting year and needs no special case
+constexpr int32_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;                                         // [0, 399]
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;  // [0, 365]
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// parseDateTime() result for text that is not a timestamp. 0 is a real time
+// (01-01-1970 00:00), so the largest value is used instead
+constexpr uint32_t INVALID_DATETIME = 0xFFFFFFFFu;
+
+// Parse "DD-MM-YYYY HH:MM" into a timestamp: minutes since 01-01-1970 00:00 of the
+// same wall-clock (no time zone), so differences are durations and /60 is the hour
+// Returns: INVALID_DATETIME if the text is malformed, not a real date/time or before 1970
+constexpr uint32_t parseDateTime(string_view dateTime) {
+    if (dateTime.size() != 16 || dateTime[10] != ' ' || dateTime[13] != ':') return INVALID_DATETIME;
+
+    uint32_t date = parseDate(dateTime.substr(0, 10));
+    unsigned bad = 0;
+    int hour = digits2(dateTime, 11, bad);
+    int minute = digits2(dateTime, 14, bad);
+    if (date == 0 || bad != 0 || hour > 23 || minute > 59) return INVALID_DATETIME;
+
+    int32_t day = daysFromCivil(date >> 9, (date >> 5) & 0xF, date & 0x1F);
+    if (day < 0) return INVALID_DATETIME;
+    return (uint32_t)day * 1440 + (uint32_t)hour * 60 + (uint32_t)minute;
+}
+
+#endif // DATEPARSE_H
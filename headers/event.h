@@ -4,6 +4,8 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <atomic>
+#include <cstdint>
 
 using namespace std;
 
@@ -13,18 +15,28 @@ class Event {
 private:
     string eventName;
     string date;          // Format: DD-MM-YYYY
+    int32_t day;          // The date as a day number (see dayNumber() in utils), parsed once
     string venue;
-    int capacity;
-    int registeredCount;
+    // Seat counter: reserved with a compare-and-swap loop against capacity, so two
+    // threads can never both take the last seat and different events never contend.
+    // The count is derived from the registration index: EventStore rebuilds it at load
+    // and keeps it in step with every registration, it is never trusted from disk.
+    atomic<int> capacity;
+    atomic<int> registeredCount;
 
 public:
     // Constructor
     Event(string name = "", string d = "", string v = "", int cap = 0, int reg = 0);
 
+    // Atomics cannot be copied, so copying takes a snapshot of both counters
+    Event(const Event& other);
+    Event& operator=(const Event& other);
+
     // Getters
-    string getEventName() const;
-    string getDate() const;
-    string getVenue() const;
+    const string& getEventName() const;
+    const string& getDate() const;
+    int32_t getDayNumber() const;
+    const string& getVenue() const;
     int getCapacity() const;
     int getRegisteredCount() const;
     int getAvailableSeats() const;
@@ -39,7 +51,19 @@ public:
     // Check if event has available seats
     bool hasAvailableSeats() const;
 
-    // Increment registered count
+    // Take one seat if any is left (lock-free, safe from any thread)
+    // Returns: false if the event is full
+    bool tryReserveSeat();
+
+    // Take up to 'wanted' seats at once (one atomic step for a whole batch)
+    // Returns: how many seats were taken (fewer than wanted if the event fills up)
+    int tryReserveSeats(int wanted);
+
+    // Give one seat back (never goes below 0)
+    // Returns: false if no seat was taken
+    bool releaseSeat();
+
+    // Count a registration that is already in the index (no capacity check)
     void registerStudent();
 
     // Decrement registered count
@@ -0,0 +1,271 @@
+#ifndef EVENTSTORE_H
+#define EVENTSTORE_H
+
+#include "event.h"
+#include "registration.h"
+#include "registrationindex.h"
+#include "journal.h"
+#include "searchindex.h"
+#include "utils.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <set>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std;
+
+// Outcome of a register/unregister request
+enum RegistrationStatus {
+    REGISTRATION_OK,
+    REGISTRATION_DUPLICATE,     // Already registered for the event
+    REGISTRATION_FULL,          // No seats left
+    REGISTRATION_NO_EVENT,      // No event with that name
+    REGISTRATION_NOT_FOUND,     // Not registered (unregister) / not waiting (leave waitlist)
+    REGISTRATION_WAITLISTED,    // Event full - added to the back of its waitlist
+    REGISTRATION_ALREADY_WAITING,   // Already on the event's waitlist
+    REGISTRATION_FAILED         // The log could not be written
+};
+
+// Short description of a status ("event is full", ...)
+string registrationStatusMessage(RegistrationStatus status);
+
+// ==================== EVENT STORE CLASS ====================
+
+// One process-wide, in-memory copy of events.txt and registrations.txt.
+// Admin and Student both work on this shared copy instead of re-reading the files
+// on every menu action. The files are only re-read when they change on disk and
+// only the modified file is written back.
+//
+// Registrations are journaled: each register/unregister is appended to
+// registrations.log instead of rewriting both data files. Once the log grows past
+// a threshold it is compacted into events.txt/registrations.txt on a background
+// thread. At startup the snapshot files are loaded and the log is replayed on top.
+// A change is reported as done only once its record is on disk; concurrent changes
+// share one flush (group commit). Snapshot files are replaced with fsync + rename,
+// so after a crash each file is either the old or the new version in full.
+//
+// A full event has a FIFO waitlist (waitlist.txt, journaled as W/L records). When a
+// registration is removed its seat goes straight to the first waiter; raising the
+// capacity promotes as many waiters as there are new seats.
+//
+// Threading: register/unregister may run on many threads at once. They hold the
+// catalog lock shared and rely on the sharded RegistrationIndex, the atomic seat
+// counters and the Journal's own lock, so changes to different events never wait
+// for each other. Anything that replaces or reshapes the data (refresh, save,
+// compaction, renaming) holds the catalog lock exclusively. Readers that walk the
+// event list while other threads register take readLock() first.
+class EventStore {
+private:
+    string eventsPath;
+    string registrationsPath;
+    string journalPath;
+    string compactingPath;    // Log being folded into the snapshot files
+    string binarySnapshotPath;  // Optional binary copy of both snapshot files
+    string waitlistPath;        // Waitlists as of the last compaction
+    string commitPath;          // files.commit: exists while writeDataFiles() renames its files
+
+    vector<Event> events;
+    RegistrationIndex registrations;    // Hash-indexed by (student, event), student and event
+    unordered_map<SymbolId, size_t> eventPositions;    // Event ID -> position in 'events'
+    SearchIndex searchIndex;            // Trigrams of event names and venues
+    set<pair<int32_t, SymbolId>> dateIndex;    // (day number, event ID), sorted by date
+
+    // Shared: register/unregister and readers. Exclusive: reload, save, compaction
+    mutable shared_mutex catalogLock;
+
+    Journal journal;
+    atomic<size_t> journalRecords;    // Records in the log since the last compaction
+    atomic<size_t> compactionThreshold;    // Compact once the log holds this many records
+
+    // Background compaction
+    thread compactionThread;
+    atomic<bool> compactionDone;
+
+    // Stamps of the files as we last read or wrote them
+    FileStamp eventsStamp;
+    FileStamp registrationsStamp;
+    FileStamp journalStamp;
+    FileStamp waitlistStamp;
+    atomic<bool> journalRestampNeeded;    // We appended since journalStamp was taken
+
+    // Has the data been loaded at least once?
+    bool loaded;
+
+    // Has the in-memory copy been modified since the last save?
+    bool eventsModified;
+    bool registrationsModified;
+
+    // Events whose stored seat count was wrong at the last load (see takeRebuiltCounts)
+    size_t rebuiltCounts;
+
+    // Load from / also write the binary snapshot (snapshot.h)?
+    bool binarySnapshotEnabled;
+
+    // File I/O Operations
+    bool loadFromFiles();
+    bool binarySnapshotIsFresh() const;
+    bool writeDataFiles(const vector<Event>& eventList, const vector<Registration>& registrationList,
+                        const vector<Registration>& waiterList);
+    bool finishCommit();    // Rename the temp files listed in files.commit, then drop it
+    void applyJournalRecord(string_view record);
+    // Set each event's seat count from the index (returns how many were wrong)
+    size_t rebuildRegistrationCounts();
+    // Rebuild eventPositions, the search index and the date index from 'events'
+    void rebuildEventIndexes();
+    void eraseEvent(SymbolId eventId);    // Out of 'events' and the indexes
+    // Event edits (the caller holds the catalog lock exclusively)
+    void applyRename(Event& event, const string& newName);
+    void applyVenue(Event& event, const string& newVenue);
+    void applyDate(Event& event, const string& newDate);
+    // Journal + index changes (the caller holds the catalog lock shared)
+    RegistrationStatus recordRegistration(const Registration& reg);
+    RegistrationStatus recordRemoval(const string& username, const string& eventName);
+    bool appendJournal(const string& record);
+    RegistrationStatus waitForCommit(RegistrationStatus status);
+    bool promoteWaiter(SymbolId eventId);    // Give a seat the caller holds to the first waiter
+    void restampFiles();
+
+    // Compaction
+    void startCompaction();
+    bool finishCompaction(bool wait);
+    bool compactNow();
+    void maybeCompact();    // Takes the catalog lock exclusively if the log is due
+
+public:
+    // Constructor (dataDir is the folder holding events.txt and registrations.txt)
+    EventStore(const string& dataDir = "data");
+
+    // Waits for any running compaction and flushes the journal
+    ~EventStore();
+
+    // The shared store used by Admin and Student
+    static EventStore& instance();
+
+    // Reload the data if any file changed on disk since we last read or wrote it
+    void refresh();
+
+    // Lock the catalog for reading / for changing it from outside the store
+    // (do not call register/unregister while holding either)
+    shared_lock<shared_mutex> readLock() const;
+    unique_lock<shared_mutex> writeLock();
+
+    // Access to the in-memory data (call refresh() first to pick up outside changes)
+    vector<Event>& getEvents();
+    RegistrationIndex& getRegistrations();
+
+    // Find an event by exact name (nullptr if not found)
+    Event* findEvent(string_view eventName);
+
+    // Add an event, keeping the lookup, search and date indexes up to date
+    void addEvent(const Event& event);
+
+    // Add many events under one lock (bulk import); the caller checks for duplicates
+    void addEvents(const vector<Event>& newEvents);
+
+    // Delete an event with its registrations and waitlist: one journaled "X" record,
+    // only that event's registrations are touched (through its posting list)
+    bool deleteEvent(const string& eventName);
+
+    // Rename an event; its registrations follow because they store the event's ID
+    void renameEvent(Event& event, const string& newName);
+
+    // Change an event's venue (re-indexes it for search)
+    void setEventVenue(Event& event, const string& newVenue);
+
+    // Change an event's date (moves it in the date index)
+    void setEventDate(Event& event, const string& newDate);
+
+    // The same three edits by event name: the event is looked up and changed under one
+    // write lock, so it cannot be deleted or moved by another thread in between
+    // (the Event& versions are for the single-threaded console menus)
+    // Returns: false if there is no such event
+    bool renameEvent(const string& eventName, const string& newName);
+    bool setEventVenue(const string& eventName, const string& newVenue);
+    bool setEventDate(const string& eventName, const string& newDate);
+
+    // The three queries below read the indexes under the catalog's read lock, which
+    // they take themselves (do not call them while holding readLock()). The returned
+    // pointers are valid until the catalog is next changed.
+
+    // Events whose name / venue contains 'query' (case-insensitive), in catalog order
+    // Uses the trigram index, so it does not scan the whole catalog
+    vector<Event*> searchEvents(string_view query, SearchField field);
+
+    // Events dated firstDay..lastDay inclusive (day numbers, see dayNumber() in utils),
+    // sorted by date. O(log n + k) through the date index
+    vector<Event*> eventsBetween(int32_t firstDay, int32_t lastDay);
+
+    // Events from today on, sorted by date (at most 'limit')
+    vector<Event*> upcomingEvents(size_t limit = SIZE_MAX);
+
+    // Register / unregister a student with every check done here (event exists,
+    // not a duplicate, seats left), so the console and the server share one path
+    RegistrationStatus registerStudent(const string& username, const string& eventName,
+                                       const string& dateTime);
+    RegistrationStatus unregisterStudent(const string& username, const string& eventName);
+
+    // Register a whole list of students for one event (e.g. a class section).
+    // Capacity is checked once for the batch and every accepted registration is
+    // journaled in one "B" record with one disk flush, so the batch is all-or-nothing
+    // on disk. Students already registered (or listed twice) get REGISTRATION_DUPLICATE;
+    // if the event fills mid-batch, the ones past the last seat get REGISTRATION_FULL.
+    // Returns: one status per username, in the same order
+    vector<RegistrationStatus> registerStudents(const string& eventName, const vector<string>& usernames,
+                                                const string& dateTime);
+
+    // Waitlist: joining registers right away if a seat is free and nobody is waiting,
+    // otherwise the student is queued (REGISTRATION_WAITLISTED) and registered
+    // automatically when a seat frees up - no need to retry
+    RegistrationStatus joinWaitlist(const string& username, const string& eventName,
+                                    const string& dateTime);
+    RegistrationStatus leaveWaitlist(const string& username, const string& eventName);
+
+    // Hand an event's free seats to its waitlist (after raising the capacity)
+    // Returns: how many students were promoted
+    size_t promoteWaiters(const string& eventName);
+
+    // Mark data as changed so the next save() writes it back
+    void markEventsModified();
+    void markRegistrationsModified();
+
+    // Write back only the files whose data was modified
+    bool save();
+
+    // Flush journaled records to disk
+    // (register/unregister already wait for their own records - group commit)
+    bool sync();
+
+    // Disk flushes of the journal so far (commits per flush shows the grouping)
+    uint64_t getSyncCount() const;
+
+    // Number of events whose stored seat count disagreed with their registrations at
+    // the last load (then resets to 0). The counts were fixed in memory and the events
+    // are marked modified, so the next save() writes the fix; reporting it is up to
+    // the caller (console, server or CLI)
+    size_t takeRebuiltCounts();
+
+    // How many log records trigger a background compaction
+    void setCompactionThreshold(size_t records);
+
+    // Keep a binary snapshot next to the text files (loaded instead of parsing text)
+    // Enabling writes snapshot.bin now; disabling deletes it (whether the file exists
+    // is what turns binary loading on at the next start)
+    bool setBinarySnapshot(bool enabled);
+
+    // Snapshot file readers (text format)
+    static bool readEventsFile(const string& path, vector<Event>& events);
+    static bool readRegistrationsFile(const string& path, RegistrationIndex& registrations);
+    static bool readWaitlistFile(const string& path, RegistrationIndex& registrations);
+
+    // Snapshot file writers (write to a temp file, then rename over the target)
+    static bool writeEventsFile(const string& path, const vector<Event>& events);
+    static bool writeRegistrationsFile(const string& path, const vector<Registration>& registrations);
+};
+
+#endif // EVENTSTORE_H
@@ -0,0 +1,60 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include "eventstore.h"
+#include "userdirectory.h"
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// ==================== BULK IMPORT ====================
+
+// Non-interactive CSV import of events and student accounts.
+//   events.csv    name,date,venue,capacity        (date DD-MM-YYYY)
+//   students.csv  username,password,full name
+// A first row naming the columns ("name,..." / "username,...") is skipped. Fields
+// may be quoted ("Fest, Day 1") with "" for a literal quote.
+//
+// The file is streamed once; rows are then checked in parallel on a worker pool
+// (field count, date, capacity, ...), duplicates are found with one hash set that
+// holds the existing names plus the file's, and student passwords are hashed in
+// parallel on the verifier pool. Rows with problems are reported by line number
+// and skipped; every valid row is committed together in a single write.
+
+// A problem with one line of the file
+struct ImportError {
+    size_t line;
+    string message;
+};
+
+// Outcome of an import
+struct ImportReport {
+    bool fileRead;                 // false if the file could not be opened
+    size_t rows;                   // Data rows (header and blank lines not counted)
+    size_t imported;               // Rows that were added
+    bool committed;                // The single write succeeded
+    vector<ImportError> errors;    // In line order
+
+    ImportReport();
+
+    // Print every error and a one-line summary
+    void print() const;
+};
+
+// parseCsvLine() value for 'rawField' when every unquoted field is trimmed
+const size_t NO_RAW_FIELD = SIZE_MAX;
+
+// Split one CSV line into fields (handles quotes). Unquoted fields are trimmed except
+// field number 'rawField'. Returns false on an unterminated quote
+bool parseCsvLine(string_view line, vector<string>& fields, size_t rawField = NO_RAW_FIELD);
+
+// Import events into the store (one save of events.txt)
+ImportReport importEvents(const string& csvPath, EventStore& store);
+
+// Import student accounts into the directory (one append to users.txt)
+ImportReport importStudents(const string& csvPath, UserDirectory& directory);
+
+#endif // IMPORTER_H
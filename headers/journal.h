@@ -0,0 +1,82 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== JOURNAL CLASS ====================
+
+// Append-only write-ahead log (one record per line).
+// Each change is appended as a single short line instead of rewriting a whole file.
+//
+// Group commit: append() only writes the record and returns its sequence number;
+// waitDurable() blocks until that record is on disk. The first waiter becomes the
+// leader and runs one fdatasync() covering every record written so far, while the
+// others wait for it - so N concurrent commits cost one disk flush, not N, and
+// throughput grows with the number of commits in flight.
+// All methods are thread-safe.
+class Journal {
+private:
+    string path;
+    int fd;                       // POSIX file descriptor (-1 when closed)
+    uint64_t appendedRecords;     // Sequence number of the last record written
+    uint64_t durableRecords;      // Every record up to this one is on disk
+    uint64_t syncCount;           // fdatasync() calls so far (statistics)
+    bool flushing;                // A leader is flushing right now (without the lock)
+    mutable mutex lock;           // Guards all of the above
+    condition_variable flushed;   // Signalled when a flush finishes
+
+    // Same as sync() / close(), for callers already holding the lock
+    bool syncLocked(unique_lock<mutex>& guard);
+    void closeLocked(unique_lock<mutex>& guard);
+
+public:
+    // Constructor (the file is opened lazily on the first append)
+    Journal(const string& logPath);
+
+    // Flushes and closes the file
+    ~Journal();
+
+    // Copying would share the file descriptor
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    string getPath() const;
+
+    // Write one record (a line without the trailing newline)
+    // Returns: its sequence number (numbered from 1), or 0 if it could not be written
+    uint64_t append(const string& record);
+
+    // Block until every record up to 'sequence' is on disk (group commit)
+    // Returns: false if the disk flush failed
+    bool waitDurable(uint64_t sequence);
+
+    // Force all appended records to disk
+    bool sync();
+
+    // Number of disk flushes so far (records per flush = commits grouped together)
+    uint64_t getSyncCount() const;
+
+    // Flush and close the file (it is reopened on the next append)
+    void close();
+
+    // Move the current log to newPath and start an empty one
+    // Used by compaction: records in newPath are folded into the snapshot files
+    bool rotate(const string& newPath);
+
+    // Remove the log file (after its records were folded into a snapshot)
+    bool discard();
+
+    // Read every record of a log file in order
+    // Returns the number of records read (0 if the file does not exist)
+    static size_t replay(const string& logPath, const function<void(string_view)>& apply);
+};
+
+#endif // JOURNAL_H
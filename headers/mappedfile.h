@@ -0,0 +1,50 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+
+using namespace std;
+
+// ==================== MAPPED FILE CLASS ====================
+
+// A read-only memory map of a whole file.
+// The file's bytes are available as one string_view without reading them into a
+// buffer; the OS pages them in on demand.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // A mapping cannot be copied (it would be unmapped twice)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map a file. Returns false if it cannot be opened (an empty file maps fine)
+    bool open(const string& path);
+
+    // Unmap the file
+    void close();
+
+    // The file's contents (valid until close())
+    string_view view() const;
+    size_t size() const;
+};
+
+// ==================== STREAMING LINE SCANNER ====================
+
+// Call onLine() for every non-empty line of a file, in order.
+// The file is mapped one window at a time and newlines are found with memchr, so
+// lines are handed out as views without being copied, and files larger than RAM
+// can be scanned (each window is released before the next one is mapped).
+// A view is only valid during its callback.
+// Returns: false if the file could not be opened
+bool forEachLine(const string& path, const function<void(string_view)>& onLine);
+
+#endif // MAPPEDFILE_H
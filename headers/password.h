@@ -0,0 +1,62 @@
+#ifndef PASSWORD_H
+#define PASSWORD_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// ==================== PASSWORD HASHING ====================
+
+// Passwords are stored in users.txt as salted PBKDF2-HMAC-SHA256 hashes:
+//   $pbkdf2-sha256$<iterations>$<salt hex>$<hash hex>
+// The iteration count is the cost parameter: every hash records the cost it was
+// made with, so changing the cost only affects newly written hashes.
+// Entries without the "$pbkdf2-sha256$" prefix are legacy plaintext passwords;
+// they still verify, and are re-hashed on the next successful login.
+
+const int PASSWORD_DEFAULT_COST = 20000;    // PBKDF2 iterations
+const int PASSWORD_MIN_COST = 10000;        // Lowest cost accepted from EVENT_PASSWORD_COST
+const size_t PASSWORD_SALT_BYTES = 16;
+const size_t PASSWORD_HASH_BYTES = 32;
+
+// Cost used for newly hashed passwords
+// main() sets it from the EVENT_PASSWORD_COST environment variable at startup (checked
+// against PASSWORD_MIN_COST); setPasswordCost itself accepts any positive cost so the
+// benchmarks can measure cheap ones
+int getPasswordCost();
+void setPasswordCost(int iterations);
+
+// Hash a password with a fresh random salt at the current cost
+string hashPassword(const string& password);
+
+// Hash a password with a given salt and cost (deterministic)
+string hashPassword(const string& password, const string& salt, int iterations);
+
+// Check an entered password against a stored entry (hashed or plaintext)
+// The comparison takes the same time wherever the first difference is
+bool verifyPassword(const string& stored, const string& password);
+
+// Is this stored entry a hash (as opposed to a legacy plaintext password)?
+bool isHashedPassword(const string& stored);
+
+// Should this entry be re-hashed (plaintext, or hashed at a different cost)?
+bool passwordNeedsRehash(const string& stored);
+
+// ==================== PRIMITIVES ====================
+
+// SHA-256 of a byte string (32 raw bytes)
+string sha256(const string& data);
+
+// HMAC-SHA256 (32 raw bytes)
+string hmacSha256(const string& key, const string& message);
+
+// PBKDF2-HMAC-SHA256 with 'length' bytes of output
+string pbkdf2Sha256(const string& password, const string& salt, int iterations, size_t length);
+
+// Raw bytes <-> lowercase hex
+string toHex(const string& bytes);
+bool fromHex(const string& hex, string& bytes);
+
+#endif // PASSWORD_H
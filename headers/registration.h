@@ -1,28 +1,40 @@
 #ifndef REGISTRATION_H
 #define REGISTRATION_H
 
+#include "symboltable.h"
+#include "utils.h"
 #include <string>
 #include <iostream>
+#include <cstdint>
 
 using namespace std;
 
 // ==================== REGISTRATION CLASS ====================
 
+// A registration is two interned IDs and a timestamp (12 bytes).
+// Names are looked up in userSymbols()/eventSymbols() only for display and file output.
 class Registration {
 private:
-    string studentUsername;
-    string eventName;
-    string registrationDate;  // Format: DD-MM-YYYY HH:MM
+    SymbolId studentId;
+    SymbolId eventId;
+    Timestamp registeredAt;   // Minutes since 01-01-1970 (see Timestamp in utils.h)
 
 public:
-    // Constructor
+    // Constructor from names (interns them) and a "DD-MM-YYYY HH:MM" timestamp
     Registration(string username = "", string event = "", string regDate = "");
 
+    // Constructor from already interned IDs and a timestamp
+    Registration(SymbolId student, SymbolId event, Timestamp timestamp);
+
     // Getters
-    string getStudentUsername() const;
-    string getEventName() const;
+    const string& getStudentUsername() const;
+    const string& getEventName() const;
     string getRegistrationDate() const;
 
+    SymbolId getStudentId() const;
+    SymbolId getEventId() const;
+    Timestamp getRegisteredAt() const;
+
     // Format registration data for file storage
     string toFileFormat() const;
 
@@ -0,0 +1,182 @@
+#ifndef REGISTRATIONINDEX_H
+#define REGISTRATIONINDEX_H
+
+#include "registration.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== REGISTRATION INDEX CLASS ====================
+
+// All registrations, indexed three ways:
+//   - a hash map keyed by (student ID, event ID) packed into one 64-bit integer
+//                                             -> "already registered?" in O(1)
+//   - a posting list per student              -> "my registrations" in O(k)
+//   - a posting list per event                -> "participants of event X" in O(k)
+// Registrations are stored in slots; removing one leaves a tombstone that is
+// reclaimed once tombstones outnumber live registrations. Each slot remembers its
+// position in both posting lists, so removal swaps the list's last entry into the
+// hole in O(1). Posting lists are therefore unordered; every registration gets a
+// sequence number when added, and listings sort by it to keep the order they were
+// added in (the file order).
+//
+// The index is sharded by event ID: each shard has its own lock and holds every
+// registration of the events that map to it, so changes to different events
+// (usually) touch different shards and never wait for each other. All methods
+// are thread-safe; listings return copies, not pointers into a shard.
+//
+// Each event also has a FIFO waitlist, kept in the event's shard next to its
+// registrations. A waiter is stored as a Registration whose timestamp is the time
+// they joined. promoteWaiter() pops the first waiter and registers them under the
+// same shard lock, in O(1). Leaving the waitlist only forgets the waiter's ticket;
+// the stale queue entry is skipped (and dropped) when it reaches the front. Each
+// shard also lists its waiters by student, so "my waitlists" does not scan the queues.
+class RegistrationIndex {
+private:
+    static const size_t SHARD_COUNT = 64;
+
+    // One event's waitlist: entries in joining order, each with its ticket
+    struct WaitQueue {
+        deque<pair<uint64_t, Registration>> entries;
+        size_t live = 0;                    // Entries whose ticket is still current
+    };
+
+    struct Shard {
+        mutable mutex lock;
+        vector<Registration> slots;
+        vector<uint64_t> sequence;          // Order in which each slot was added
+        vector<bool> live;                  // live[i] == false means slot i is a tombstone
+        vector<size_t> studentPosition;     // Where slot i sits in its student's posting list
+        vector<size_t> eventPosition;       // ... and in its event's posting list
+        size_t liveCount = 0;
+
+        unordered_map<uint64_t, size_t> slotByKey;
+        unordered_map<SymbolId, vector<size_t>> slotsByStudent;
+        unordered_map<SymbolId, vector<size_t>> slotsByEvent;
+
+        unordered_map<SymbolId, WaitQueue> waitlists;
+        unordered_map<uint64_t, uint64_t> waitTickets;    // (student, event) -> current ticket
+        // student -> (event -> its current queue entry), for waitlistForStudent()
+        unordered_map<SymbolId, unordered_map<SymbolId, pair<uint64_t, Registration>>> waitsByStudent;
+
+        void clear();
+        void clearSlots();
+        void insert(const Registration& reg, uint64_t order);
+        bool dropWaiter(uint64_t key);
+        void forgetWait(SymbolId studentId, SymbolId eventId);
+        bool isCurrent(const pair<uint64_t, Registration>& entry) const;
+        void removeSlot(size_t slot);
+        void reclaimTombstones();
+    };
+
+    Shard shards[SHARD_COUNT];
+    atomic<uint64_t> nextSequence;
+
+    // (student, event) -> one 64-bit hash key
+    static uint64_t makeKey(SymbolId studentId, SymbolId eventId);
+
+    Shard& shardFor(SymbolId eventId);
+    const Shard& shardFor(SymbolId eventId) const;
+
+    // Registrations with their sequence numbers, merged back into insertion order
+    static vector<Registration> inOrder(vector<pair<uint64_t, Registration>>& entries);
+
+public:
+    RegistrationIndex();
+
+    RegistrationIndex(const RegistrationIndex&) = delete;
+    RegistrationIndex& operator=(const RegistrationIndex&) = delete;
+
+    // Remove everything
+    void clear();
+
+    // Number of live registrations
+    size_t size() const;
+    bool empty() const;
+
+    // Is this student registered for this event?  O(1)
+    bool contains(SymbolId studentId, SymbolId eventId) const;
+    bool contains(const string& username, const string& eventName) const;
+
+    // Copy the registration for (student, event) into 'result'. Returns false if none  O(1)
+    bool find(SymbolId studentId, SymbolId eventId, Registration& result) const;
+
+    // Add a registration. Returns false if (student, event) is already registered.
+    // 'commit' (optional) runs under the shard's lock after the duplicate check and
+    // before the registration is stored; if it returns false nothing is stored.
+    // Used to write the journal record in the same order as the index changes.
+    bool add(const Registration& reg, const function<bool()>& commit = nullptr);
+
+    // Add several registrations of ONE event under a single shard lock (batch enrolment).
+    // Entries already registered, or repeated in 'regs', are flagged in 'duplicate' and
+    // dropped. 'commit' gets the rest in order and may shorten the list (e.g. to the
+    // seats left); it runs before anything is stored and false stores nothing.
+    // Returns: false if the commit failed
+    bool addBatch(const vector<Registration>& regs, vector<bool>& duplicate,
+                  const function<bool(vector<Registration>&)>& commit = nullptr);
+
+    // Remove the registration for (student, event). Returns false if not found
+    // 'commit' works as for add(): it runs first, and false cancels the removal
+    bool remove(SymbolId studentId, SymbolId eventId, const function<bool()>& commit = nullptr);
+    bool remove(const string& username, const string& eventName);
+
+    // Remove every registration for an event. Returns how many were removed  O(k)
+    size_t removeEvent(SymbolId eventId);
+
+    // Registrations of one student / of one event, in the order they were added
+    // forEvent is O(k log k); forStudent looks at the student's list in every shard
+    vector<Registration> forStudent(const string& username) const;
+    vector<Registration> forEvent(const string& eventName) const;
+
+    // Number of registrations for an event  O(1)
+    size_t countForEvent(SymbolId eventId) const;
+    size_t countForEvent(const string& eventName) const;
+
+    // Visit every live registration in order (visits a copy taken shard by shard)
+    void forEach(const function<void(const Registration&)>& visit) const;
+
+    // Copy of all live registrations in order (used to write the snapshot file)
+    vector<Registration> toVector() const;
+
+    // ==================== WAITLISTS ====================
+
+    // Put a student at the back of an event's waitlist ('reg' holds the join time).
+    // Returns false if they are already registered or already waiting.
+    // 'commit' works as for add()
+    bool addWaiter(const Registration& reg, const function<bool()>& commit = nullptr);
+
+    // Take a student off an event's waitlist. Returns false if they were not on it
+    bool removeWaiter(SymbolId studentId, SymbolId eventId, const function<bool()>& commit = nullptr);
+
+    // Register the first waiter of an event, stamped 'registeredAt'  O(1)
+    // 'commit' gets the new registration before it is stored; false cancels.
+    // Returns false if nobody is waiting (or the commit failed)
+    bool promoteWaiter(SymbolId eventId, Timestamp registeredAt,
+                       const function<bool(const Registration&)>& commit = nullptr,
+                       Registration* promoted = nullptr);
+
+    bool isWaiting(SymbolId studentId, SymbolId eventId) const;
+
+    // Number of students waiting for an event  O(1)
+    size_t waitingForEvent(SymbolId eventId) const;
+
+    // 1-based place in the event's waitlist, 0 if not waiting  O(k)
+    size_t waitlistPosition(SymbolId studentId, SymbolId eventId) const;
+
+    // Waitlists a student is on (in joining order) / one event's waitlist (in order)
+    // waitlistForStudent is O(shards + k), through each shard's per-student list
+    vector<Registration> waitlistForStudent(const string& username) const;
+    vector<Registration> waitlistForEvent(const string& eventName) const;
+
+    // Every waiter of every event, in joining order (used to write waitlist.txt)
+    vector<Registration> waitersToVector() const;
+};
+
+#endif // REGISTRATIONINDEX_H
@@ -0,0 +1,51 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "event.h"
+#include "registrationindex.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ==================== REPORT ENGINE ====================
+
+// Registration numbers for one event
+struct EventSummary {
+    string eventName;
+    int capacity;
+    int registered;
+
+    // Percentage of seats taken (0 if capacity is 0)
+    double occupancy() const;
+};
+
+// Registration numbers for the whole catalog
+// Shared by Admin::displayEventStats and the registration summary report,
+// so both screens always show the same counts
+struct RegistrationSummary {
+    vector<EventSummary> events;    // Same order as the event list
+    long totalCapacity;
+    long totalRegistered;
+
+    RegistrationSummary();
+
+    double occupancy() const;
+};
+
+// Build the summary in O(E): per-event counts come from the registration index,
+// which keeps them up to date as registrations are added and removed
+RegistrationSummary buildRegistrationSummary(const vector<Event>& events,
+                                             const RegistrationIndex& registrations);
+
+// Registrations made within one clock hour
+struct HourlyCount {
+    Timestamp hourStart;      // First minute of the hour
+    size_t registrations;
+};
+
+// Registrations per hour, in time order (hours without registrations are left out).
+// One pass: each registration's bucket is just its timestamp / 60, no date parsing
+vector<HourlyCount> buildHourlyRegistrations(const RegistrationIndex& registrations);
+
+#endif // REPORT_H
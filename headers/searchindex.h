@@ -0,0 +1,67 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include "symboltable.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+// Which text of an event a search looks at
+enum SearchField {
+    SEARCH_NAME,
+    SEARCH_VENUE
+};
+
+// ==================== SEARCH INDEX CLASS ====================
+
+// Trigram index for case-insensitive substring search over event names and venues.
+// Every event (keyed by its interned event ID) keeps a lowercased copy of its name
+// and venue, and each field has a posting list per trigram (3 consecutive bytes)
+// listing the events whose text contains it.
+//
+// A query of 3+ characters can only match events that contain all of its trigrams,
+// so search() walks the shortest of those posting lists and checks each candidate
+// with one find() on the stored lowercase text - the work depends on how many
+// events share the query's rarest trigram, not on the size of the catalog.
+// Queries of 1-2 characters have no trigram and scan the stored texts.
+//
+// Not thread-safe on its own: EventStore changes it under its exclusive catalog lock.
+class SearchIndex {
+private:
+    struct Entry {
+        string text[2];    // Lowercased name and venue (indexed by SearchField)
+    };
+
+    unordered_map<SymbolId, Entry> entries;
+    unordered_map<uint32_t, vector<SymbolId>> postings[2];    // Trigram -> event IDs
+
+    // Distinct trigrams of a lowercase text (3 bytes packed into one integer)
+    static vector<uint32_t> trigramsOf(string_view text);
+
+    void addPostings(SymbolId eventId, SearchField field, const string& text);
+    void removePostings(SymbolId eventId, SearchField field, const string& text);
+
+public:
+    // Lowercase copy (ASCII), the form everything is indexed and searched in
+    static string fold(string_view text);
+
+    // Drop every event
+    void clear();
+
+    // Index an event, replacing what was indexed for its ID before
+    void add(SymbolId eventId, const string& name, const string& venue);
+
+    // Stop indexing an event (no-op if it is not indexed)
+    void remove(SymbolId eventId);
+
+    // Events whose field contains 'query' (case-insensitive), in no particular order
+    vector<SymbolId> search(string_view query, SearchField field) const;
+
+    size_t size() const;
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,111 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "workerpool.h"
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+using namespace std;
+
+// ==================== SERVER MODE ====================
+
+// Serves the Student and Admin operations to many clients at once over a local
+// (Unix domain) socket, using one shared in-memory EventStore.
+//
+// Protocol: one command per line, one response per command.
+//   LOGIN <username> <password>   -> OK admin|student
+//   LIST                          -> OK <n>, then n lines name|date|venue|capacity|registered
+//   REGISTER <event name>         -> OK registered            (student)
+//   UNREGISTER <event name>       -> OK unregistered          (student)
+//   WAITLIST <event name>         -> OK waitlisted <position>, or OK registered if a
+//                                    seat was free (student)
+//   LEAVE <event name>            -> OK left                  (student; leaves the waitlist)
+//   MY                            -> OK <n>, then n lines event|date|venue|registered at
+//   SUMMARY                       -> OK <n>, then n lines event|capacity|registered|occupancy
+//                                    (admin; the last line is TOTAL|...)
+//   PARTICIPANTS <event name>     -> OK <n>, then n lines username|registered at (admin)
+//   ADDEVENT <name>|<date>|<venue>|<capacity>
+//                                 -> OK added                 (admin)
+//   EDITEVENT <name>|<field>|<value>
+//                                 -> OK updated               (admin; field is name, date
+//                                    or venue)
+//   EDITEVENT <name>|capacity|<n> -> OK updated <promoted>    (admin; new seats go to the
+//                                    waitlist first, <promoted> is how many moved in)
+//   DELETEEVENT <event name>      -> OK deleted <n>           (admin; n registrations removed)
+//   QUIT                          -> OK bye, then the connection is closed
+// Any failure is answered with a single "ERR <reason>" line.
+//
+// Threading: one thread runs an epoll loop that accepts clients and waits for
+// input; each readable client is handed to a WorkerPool (EPOLLONESHOT makes sure
+// only one worker serves a given client at a time). REGISTER/UNREGISTER go
+// straight to the store, which locks per event shard; listings hold the store's
+// read lock. The user directory is shared behind usersLock; password checks run
+// on the verifier pool outside the lock. Catalog changes (ADDEVENT / EDITEVENT /
+// DELETEEVENT) are serialized by eventsEditLock, so a name checked as free is still
+// free when it is used. Events are always passed to the store by name and looked up
+// again under the store's write lock, never held as pointers between calls. Each
+// change is saved before the response is sent, like the admin menu does.
+
+// One connected client
+struct ClientConnection {
+    int fd;
+    string input;       // Bytes received but not yet ending in a newline
+    string username;    // Empty until LOGIN succeeds
+    string userType;    // "admin" or "student"
+    bool closing;       // QUIT received or the peer hung up
+
+    ClientConnection(int socketFd);
+};
+
+class Server {
+private:
+    string socketPath;
+    int listenFd;
+    int epollFd;
+    WorkerPool workers;
+    mutex usersLock;          // Serializes access to the user directory
+    mutex eventsEditLock;     // Serializes admin changes to the event catalog
+    mutex connectionsLock;    // Guards 'connections'
+    unordered_map<int, shared_ptr<ClientConnection>> connections;
+    atomic<bool> running;
+
+    bool openSocket();
+    void acceptClients();
+    void serveClient(const shared_ptr<ClientConnection>& client);
+    string handleCommand(ClientConnection& client, const string& line);
+    void closeClient(int fd);
+
+    // Command handlers (each returns the full response text)
+    string handleLogin(ClientConnection& client, const string& arguments);
+    string handleList();
+    string handleRegister(ClientConnection& client, const string& eventName);
+    string handleUnregister(ClientConnection& client, const string& eventName);
+    string handleWaitlist(ClientConnection& client, const string& eventName);
+    string handleLeave(ClientConnection& client, const string& eventName);
+    string handleMyRegistrations(ClientConnection& client);
+    string handleSummary();
+    string handleParticipants(const string& eventName);
+    string handleAddEvent(const string& arguments);
+    string handleEditEvent(const string& arguments);
+    string handleDeleteEvent(const string& eventName);
+
+public:
+    // threadCount 0 = one worker per hardware thread
+    Server(const string& path = "data/server.sock", size_t threadCount = 0);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Listen and serve until stop() is called
+    // Returns: false if the socket could not be opened
+    bool run();
+
+    // Ask run() to return (safe to call from a signal handler)
+    void stop();
+};
+
+#endif // SERVER_H
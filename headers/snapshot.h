@@ -0,0 +1,57 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "event.h"
+#include "registration.h"
+#include "registrationindex.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== BINARY SNAPSHOT FORMAT ====================
+
+// A binary, column-oriented copy of events.txt + registrations.txt.
+// Loading it is a memory map plus array reads: no splitting, trimming or stoi.
+// The text files remain the interchange format; convert with the functions below.
+//
+// File layout (all integers little-endian, every column 4-byte aligned):
+//   SnapshotHeader
+//   event columns         nameId[E]  venueOffset[E]  venueLength[E]
+//                         date[E]  capacity[E]  registered[E]
+//   registration columns  studentId[R]  eventId[R]  registeredAt[R]
+//   symbol columns        userOffset[U]  userLength[U]  eventOffset[N]  eventLength[N]
+//   string heap           heapSize bytes of names and venues (not null-terminated)
+// IDs in the file are local to the file; they are re-interned when loaded.
+
+const char SNAPSHOT_MAGIC[8] = {'E', 'V', 'M', 'S', 'N', 'A', 'P', '\0'};
+// registeredAt holds Timestamps (minutes since 1970, INVALID_TIMESTAMP for "no time",
+// see utils.h). Files with any other version are rejected and the text files are read.
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t eventCount;          // E
+    uint32_t registrationCount;   // R
+    uint32_t userCount;           // U - usernames in the string heap
+    uint32_t eventNameCount;      // N - event names in the string heap
+    uint32_t reserved;
+    uint64_t heapSize;
+};
+
+// Write events and registrations to a binary snapshot (temp file + rename)
+bool writeSnapshot(const string& path, const vector<Event>& events,
+                   const vector<Registration>& registrations);
+
+// Load a binary snapshot (memory-mapped). Returns false if missing or invalid
+bool readSnapshot(const string& path, vector<Event>& events, RegistrationIndex& registrations);
+
+// Converters between the text files and the binary snapshot
+bool convertTextToSnapshot(const string& eventsPath, const string& registrationsPath,
+                           const string& snapshotPath);
+bool convertSnapshotToText(const string& snapshotPath, const string& eventsPath,
+                           const string& registrationsPath);
+
+#endif // SNAPSHOT_H
@@ -4,6 +4,7 @@
 #include "user.h"
 #include "event.h"
 #include "registration.h"
+#include "eventstore.h"
 #include "utils.h"
 #include <vector>
 #include <fstream>
@@ -26,12 +27,6 @@ public:
     // Virtual method implementation
     string getUserType() override;
     
-    // File I/O Operations
-    vector<Event> loadEventsFromFile();
-    bool saveEventsToFile(const vector<Event>& events);
-    vector<Registration> loadRegistrationsFromFile();
-    bool saveRegistrationsToFile(const vector<Registration>& registrations);
-    
     // Utility for timestamps
     string getCurrentDateTime();
     
@@ -42,6 +37,7 @@ public:
     // Registration Management
     void registerForEvent();
     void unregisterFromEvent(const string& eventName);
+    void offerWaitlist(const string& eventName);
     
     // Search and Filter
     void searchEventByName();
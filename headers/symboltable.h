@@ -0,0 +1,72 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== SYMBOL TABLE CLASS ====================
+
+// Compact integer ID standing in for a name (event name or username)
+typedef uint32_t SymbolId;
+
+// Returned by SymbolTable::find() when a name was never interned
+const SymbolId NO_SYMBOL = 0xFFFFFFFFu;
+
+// Interns names: each distinct name is stored once and gets a small integer ID.
+// Lookups take a string_view, so a name can be found straight from a line buffer
+// without building a std::string first.
+// Records keep the ID instead of a string copy, comparisons become integer
+// compares, and renaming a symbol renames it everywhere at once.
+//
+// Thread-safe: intern() and find() share a reader/writer lock (only adding a new
+// name takes it exclusively). name() takes no lock at all: names live in fixed-size
+// chunks that are never moved or freed, so an ID's string can be read while other
+// threads are adding names. rename() must not race with readers of that ID.
+class SymbolTable {
+private:
+    static const size_t CHUNK_BITS = 12;                  // 4096 names per chunk
+    static const size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static const size_t MAX_CHUNKS = 65536;               // Room for 268M names
+
+    atomic<string*> chunks[MAX_CHUNKS];       // ID -> name, allocated chunk by chunk
+    atomic<SymbolId> count;                   // Number of IDs handed out
+    unordered_map<string_view, SymbolId> ids; // name -> ID (views into the chunks)
+    mutable shared_mutex lock;                // Guards 'ids' and adding names
+
+    string& slot(SymbolId id) const;
+
+public:
+    SymbolTable();
+    ~SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // ID for a name, adding it if it is new
+    SymbolId intern(string_view name);
+
+    // ID for a name, or NO_SYMBOL if it was never interned
+    SymbolId find(string_view name) const;
+
+    // Name for an ID (used for display and file output)
+    const string& name(SymbolId id) const;
+
+    // Give an ID a new name. If another ID already had that name, the name now
+    // resolves to this ID (the other ID keeps displaying its old name)
+    void rename(SymbolId id, const string& newName);
+
+    // Number of interned names
+    size_t size() const;
+};
+
+// The dictionaries shared by every Registration
+SymbolTable& userSymbols();
+SymbolTable& eventSymbols();
+
+#endif // SYMBOLTABLE_H
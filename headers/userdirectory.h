@@ -0,0 +1,75 @@
+#ifndef USERDIRECTORY_H
+#define USERDIRECTORY_H
+
+#include "utils.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// ==================== USER RECORD ====================
+
+// One line of users.txt: username,password,fullname,usertype
+struct UserRecord {
+    string username;
+    string password;    // Hash entry (see password.h) or legacy plaintext
+    string fullName;
+    string userType;    // "admin" or "student"
+};
+
+// ==================== USER DIRECTORY CLASS ====================
+
+// One process-wide, in-memory copy of users.txt with a hash index on username.
+// Logins, the duplicate-username check and the user listing all read from it,
+// so the file is parsed once instead of on every login attempt. It is re-read
+// only when its stamp (inode, size, mtime) changes on disk.
+class UserDirectory {
+private:
+    string usersPath;
+    vector<UserRecord> users;                      // File order (used for listings)
+    unordered_map<string, size_t> indexByName;     // Username -> position in users
+    FileStamp usersStamp;
+    bool loaded;
+
+    bool loadFromFile();
+    bool writeFile();
+    void indexUser(size_t position);
+
+public:
+    // Constructor (dataDir is the folder holding users.txt)
+    UserDirectory(const string& dataDir = "data");
+
+    // The process-wide directory used by login and Admin
+    static UserDirectory& instance();
+
+    // Reload users.txt if it changed on disk
+    // Returns: false if the file could not be opened
+    bool refresh();
+
+    // O(1) lookup by username (nullptr if there is no such user)
+    const UserRecord* find(const string& username) const;
+    bool contains(const string& username) const;
+
+    // Every user in file order
+    const vector<UserRecord>& getUsers() const;
+    size_t size() const;
+
+    // Append a user to users.txt and to the directory
+    // Returns: false if the username is taken or the file could not be written
+    bool addUser(const UserRecord& user);
+
+    // Append many users with a single write (bulk import)
+    // Returns: false if any username is taken (nothing is written) or the write failed
+    bool addUsers(const vector<UserRecord>& newUsers);
+
+    // Replace a user's stored password entry (e.g. with a new hash) and rewrite users.txt
+    bool setPassword(const string& username, const string& stored);
+
+    // Hash every legacy plaintext password at the current cost on the verifier pool
+    // and rewrite users.txt once
+    // Returns: the number of entries that were re-hashed
+    size_t migratePasswords();
+};
+
+#endif // USERDIRECTORY_H
@@ -2,10 +2,14 @@
 #define UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <ctime>
+#include <sys/types.h>
 
 using namespace std;
 
@@ -17,13 +21,100 @@ vector<string> split(const string& str, char delimiter);
 // Trim whitespace from string
 string trim(const string& str);
 
+// ==================== ZERO-COPY TOKENIZER ====================
+// These work on string_view: non-owning "windows" into an existing line buffer.
+// Nothing is copied and nothing is allocated per field.
+
+// Split a line into at most maxFields field views (written to fields[])
+// Returns: the total number of fields in the line (may be more than maxFields)
+size_t splitFields(string_view line, char delimiter, string_view* fields, size_t maxFields);
+
+// Trim whitespace from both ends of a view (returns a narrower view)
+string_view trimView(string_view str);
+
+// Parse a (trimmed) base-10 integer. Returns false if the view is not a whole number
+bool parseInt(string_view str, int& value);
+
 // Check if string contains only digits
 bool isNumeric(const string& str);
 
-// Validate date format (DD-MM-YYYY)
+// Validate a date (DD-MM-YYYY, a real calendar date, year 2025 or later)
 bool isValidDate(const string& date);
 
 // Convert string to lowercase
 string toLower(const string& str);
 
+// Pack a "DD-MM-YYYY" date into 32 bits (0 if malformed or not a real date)
+// Layout (high to low): year | month 4 bits | day 5 bits, so packed dates sort correctly
+uint32_t packDate(string_view date);
+
+// Format a packed date back to "DD-MM-YYYY" ("" for 0)
+string formatDate(uint32_t packed);
+
+// Day number of a "DD-MM-YYYY" date: days since 01-01-1970 (INVALID_DAY if malformed)
+// Consecutive dates have consecutive numbers, so date ranges are integer ranges
+const int32_t INVALID_DAY = INT32_MIN;
+int32_t dayNumber(string_view date);
+
+// Format a day number back to "DD-MM-YYYY"
+string formatDayNumber(int32_t day);
+
+// Today's day number (local time)
+int32_t todayDayNumber();
+
+// Registration timestamp: minutes since 01-01-1970 00:00 (local wall-clock time).
+// Subtracting two gives the minutes between them and timestamp / 60 is the hour,
+// so sorting and per-hour bucketing are integer operations. 32 bits last until 10136.
+typedef uint32_t Timestamp;
+
+// "No time": what parseTimestamp() returns for text it cannot read (0 is a real time,
+// 01-01-1970 00:00). Same value as INVALID_DATETIME in dateparse.h
+const Timestamp INVALID_TIMESTAMP = UINT32_MAX;
+
+// Parse "DD-MM-YYYY HH:MM" into a timestamp (INVALID_TIMESTAMP if malformed or not a
+// real date/time)
+Timestamp parseTimestamp(string_view dateTime);
+
+// Format a timestamp back to "DD-MM-YYYY HH:MM" ("" for INVALID_TIMESTAMP)
+string formatTimestamp(Timestamp timestamp);
+
+// The current local time as a timestamp
+Timestamp currentTimestamp();
+
+// Current local date/time as "DD-MM-YYYY HH:MM" (safe to call from any thread)
+string currentDateTime();
+
+// ==================== FILE STAMPS ====================
+
+// Identity and modification info of a file on disk
+// Used to detect whether a data file changed since we last read it
+struct FileStamp {
+    bool exists;
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    time_t modifiedSec;
+    long modifiedNsec;
+
+    FileStamp();
+    bool operator==(const FileStamp& other) const;
+    bool operator!=(const FileStamp& other) const;
+};
+
+// Read the current stamp of a file (exists == false if it is missing)
+FileStamp getFileStamp(const string& path);
+
+// ==================== DURABLE FILE REPLACEMENT ====================
+
+// Flush a file's contents to disk
+bool syncFile(const string& path);
+
+// Flush the directory holding 'path', so a rename or new file in it survives a crash
+bool syncParentDirectory(const string& path);
+
+// Atomically replace 'path' with the finished 'tempPath':
+// flush the temp file, rename it over the target, then flush the directory.
+// After a crash the target is either the complete old file or the complete new one.
+bool replaceFileDurably(const string& tempPath, const string& path);
+
 #endif // UTILS_H
@@ -0,0 +1,36 @@
+#ifndef VERIFIERPOOL_H
+#define VERIFIERPOOL_H
+
+#include "workerpool.h"
+#include <string>
+#include <future>
+
+using namespace std;
+
+// ==================== VERIFIER POOL CLASS ====================
+
+// Runs password hashing and verification on a WorkerPool.
+// PBKDF2 is deliberately slow, so logins are handed to the pool instead of being
+// hashed on the caller's thread. The pool is bounded (see workerpool.h): at most
+// threadCount hashes run at once and a login burst waits for a free slot.
+class VerifierPool {
+private:
+    WorkerPool workers;
+
+public:
+    // threadCount 0 = one worker per hardware thread
+    VerifierPool(size_t threadCount = 0, size_t maxQueued = 256);
+
+    // The process-wide pool used for logins
+    static VerifierPool& instance();
+
+    // Check a password against a stored entry (see password.h) on a worker
+    future<bool> verify(const string& stored, const string& password);
+
+    // Hash a password at the current cost on a worker
+    future<string> hash(const string& password);
+
+    size_t threadCount() const;
+};
+
+#endif // VERIFIERPOOL_H
@@ -0,0 +1,53 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// ==================== WORKER POOL CLASS ====================
+
+// A fixed set of worker threads draining a bounded task queue.
+// At most threadCount tasks run at once and at most queueLimit wait; submitting
+// to a full queue blocks until a worker takes a task, so a burst of work is
+// throttled instead of piling up without limit.
+// Used by VerifierPool (password hashing) and the server (client requests).
+class WorkerPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    size_t queueLimit;
+    mutex lock;
+    condition_variable taskReady;    // A task was queued (or the pool is stopping)
+    condition_variable slotFree;     // A queued task was taken by a worker
+    condition_variable idle;         // The queue is empty and no task is running
+    size_t runningTasks;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    // threadCount 0 = one worker per hardware thread
+    WorkerPool(size_t threadCount = 0, size_t maxQueued = 256);
+
+    // Finishes queued work, then stops the workers
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Queue a task, waiting while the queue is full
+    void submit(function<void()> task);
+
+    // Wait until every queued task has finished
+    void wait();
+
+    size_t threadCount() const;
+};
+
+#endif // WORKERPOOL_H
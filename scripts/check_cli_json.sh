@@ -0,0 +1,81 @@
+#!/bin/bash
+# ========================================
+# CHECK_CLI_JSON.SH - Command Line JSON Output Check
+# ========================================
+# Runs every --json subcommand on a copy of data/ whose events.txt has a wrong
+# registration count, and checks that stdout still parses as JSON (the repair note
+# must go to stderr) and that the repaired count was saved (no note on the next run).
+# Failing --json commands must exit with 1 and leave stdout empty or valid JSON.
+# Usage: scripts/check_cli_json.sh <path to event-management>
+
+BINARY=$(realpath "${1:-build/event-management}")
+DATA=$(realpath "$(dirname "$0")/../data")
+WORK=$(mktemp -d /tmp/cli-check-XXXXXX)
+trap 'rm -rf "$WORK"' EXIT
+
+cp -r "$DATA" "$WORK/data"
+cd "$WORK" || exit 1
+
+# Drift the count column (5th field) of the first event
+awk -F'|' 'BEGIN { OFS = "|" } NR == 1 { $5 = $5 + 42 } { print }' data/events.txt > events.tmp
+mv events.tmp data/events.txt
+
+FIRST_EVENT=$(head -1 data/events.txt | cut -d'|' -f1)
+FAILED=0
+
+check() {
+    if ! "$BINARY" "$@" 2> stderr.txt | python3 -m json.tool > /dev/null; then
+        echo "FAIL: '$*' did not print valid JSON"
+        FAILED=1
+    fi
+}
+
+check list-events --json
+if ! grep -q "were rebuilt" stderr.txt; then
+    echo "FAIL: the count repair was not reported on stderr"
+    FAILED=1
+fi
+check search --query e --json
+check my-registrations --user john --json
+check report summary --json
+check report participants --event "$FIRST_EVENT" --json
+
+# Failures: the error goes to stderr, stdout stays empty (or JSON)
+check_failure() {
+    if "$BINARY" "$@" > stdout.txt 2> stderr.txt; then
+        echo "FAIL: '$*' should have failed"
+        FAILED=1
+    elif [ -s stdout.txt ] && ! python3 -m json.tool stdout.txt > /dev/null 2>&1; then
+        echo "FAIL: '$*' printed non-JSON on stdout when it failed"
+        FAILED=1
+    elif ! grep -q "Error" stderr.txt; then
+        echo "FAIL: '$*' did not report its error on stderr"
+        FAILED=1
+    fi
+}
+
+check_failure report participants --event "No Such Event" --json
+check_failure report participants --json
+check_failure my-registrations --json
+check_failure search --json
+check_failure report nonsense --json
+
+# A store error (missing events.txt) is reported on stderr; stdout is still JSON
+mv data/events.txt events.saved
+check list-events --json
+if ! grep -q "Error" stderr.txt; then
+    echo "FAIL: the missing events.txt was not reported on stderr"
+    FAILED=1
+fi
+mv events.saved data/events.txt
+
+"$BINARY" list-events > /dev/null 2> stderr.txt
+if grep -q "were rebuilt" stderr.txt; then
+    echo "FAIL: the repaired counts were not saved"
+    FAILED=1
+fi
+
+if [ $FAILED -eq 0 ]; then
+    echo "✓ CLI JSON output is valid"
+fi
+exit $FAILED
@@ -36,130 +36,10 @@ string Admin::getUserType() {
     return "Admin";
 }
 
-// ==================== FILE I/O OPERATIONS ====================
-// These functions handle reading and writing data to text files
-// This is how we persist data (save it permanently) without a database
-
-// Load events from file into vector
-// What it does: Reads events.txt and creates Event objects from the data
-// Returns: Vector (dynamic array) containing all Event objects
-vector<Event> Admin::loadEventsFromFile() {
-    vector<Event> events;              // Create empty vector to store events
-    ifstream file("data/events.txt");  // Open file for reading (ifstream = input file stream)
-    string line;                       // Variable to store each line
-    
-    // Check if file opened successfully
-    if (!file.is_open()) {
-        cout << "Error: Could not open events.txt file!" << endl;
-        return events;    // Return empty vector
-    }
-    
-    // Read file line by line
-    while (getline(file, line)) {
-        if (line.empty()) continue;    // Skip empty lines
-        
-        // Split the line by pipe (|) delimiter
-        // File format: eventname|date|venue|capacity|registered
-        vector<string> parts = split(line, '|');
-        
-        // Make sure we have at least 4 parts (registered count is optional)
-        if (parts.size() >= 4) {
-            // Extract and clean each field
-            string name = trim(parts[0]);
-            string date = trim(parts[1]);
-            string venue = trim(parts[2]);
-            int capacity = stoi(trim(parts[3]));  // stoi = "string to integer"
-            
-            // Ternary operator: (condition ? if_true : if_false)
-            // If there's a 5th part, use it; otherwise use 0
-            int registered = (parts.size() > 4) ? stoi(trim(parts[4])) : 0;
-            
-            // Create Event object and add it to the vector
-            // push_back() adds an element to the end of the vector
-            events.push_back(Event(name, date, venue, capacity, registered));
-        }
-    }
-    
-    file.close();    // Always close files when done
-    return events;   // Return vector containing all events
-}
-
-// Save events to file
-// What it does: Writes all Event objects back to events.txt
-// Parameters: 'const vector<Event>&' means we pass by reference (efficient) and won't modify it
-// Returns: true if successful, false if error
-bool Admin::saveEventsToFile(const vector<Event>& events) {
-    ofstream file("data/events.txt");  // Open file for writing (ofstream = output file stream)
-    
-    // Check if file opened successfully
-    if (!file.is_open()) {
-        cout << "Error: Could not open events.txt for writing!" << endl;
-        return false;
-    }
-    
-    // Write each event to the file
-    // 'const auto&' = compiler figures out the type (Event), const means read-only, & means reference
-    for (const auto& event : events) {
-        // toFileFormat() converts Event object to pipe-delimited string
-        file << event.toFileFormat() << endl;
-    }
-    
-    file.close();    // Always close files when done
-    return true;     // Indicate success
-}
-
-// Load registrations from file
-// What it does: Reads registrations.txt and creates Registration objects
-// Similar to loadEventsFromFile but for registrations
-// Returns: Vector of Registration objects
-vector<Registration> Admin::loadRegistrationsFromFile() {
-    vector<Registration> registrations;      // Empty vector to store registrations
-    ifstream file("data/registrations.txt"); // Open registrations file
-    string line;
-    
-    // If file doesn't exist or can't open, return empty vector (not an error)
-    if (!file.is_open()) {
-        return registrations;
-    }
-    
-    // Read each line from the file
-    while (getline(file, line)) {
-        if (line.empty()) continue;    // Skip empty lines
-        
-        // Split by pipe delimiter
-        // File format: username|eventname|registrationdate
-        vector<string> parts = split(line, '|');
-        
-        // Must have exactly 3 parts
-        if (parts.size() == 3) {
-            // Create Registration object and add to vector
-            registrations.push_back(Registration(trim(parts[0]), trim(parts[1]), trim(parts[2])));
-        }
-    }
-    
-    file.close();
-    return registrations;
-}
-
-// Save registrations to file
-// What it does: Writes all Registration objects back to registrations.txt
-// Called after: A student registers or unregisters from an event
-bool Admin::saveRegistrationsToFile(const vector<Registration>& registrations) {
-    ofstream file("data/registrations.txt");  // Open for writing
-    
-    if (!file.is_open()) {
-        cout << "Error: Could not open registrations.txt for writing!" << endl;
-        return false;
-    }
-    
-    // Write each registration to file
-    for (const auto& reg : registrations) {
-        file << reg.toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
-}
+// ==================== DATA ACCESS ====================
+// Events and registrations live in the shared EventStore (see eventstore.cpp).
+// Each action calls refresh() to pick up outside changes, edits the in-memory data,
+// marks what it changed and calls save(), which writes back only the modified files.
 
 // ==================== EVENT MANAGEMENT MENU ====================
 
@@ -175,7 +55,9 @@ void Admin::manageEvents() {
         cout << "1. Add New Event" << endl;          // CREATE
         cout << "2. Edit Event" << endl;             // UPDATE
         cout << "3. Delete Event" << endl;           // DELETE
-        cout << "4. Back to Dashboard" << endl;
+        cout << "4. Import Events from CSV" << endl; // Bulk CREATE
+        cout << "5. Enroll a Class in an Event" << endl;    // Batch registration
+        cout << "6. Back to Dashboard" << endl;
         cout << "Choose an option: ";
         
         int choice;
@@ -195,6 +77,12 @@ void Admin::manageEvents() {
                 deleteEvent();    // Call function to remove an event
                 break;
             case 4:
+                importEvents();   // Add many events from a file
+                break;
+            case 5:
+                enrollClass();    // Register many students at once
+                break;
+            case 6:
                 managing = false; // Set to false to exit the loop
                 break;
             default:
@@ -203,6 +91,97 @@ void Admin::manageEvents() {
     }
 }
 
+// Import events from a CSV file (bulk CREATE)
+// What it does: Asks for the file and hands it to the importer (see importer.h),
+// which checks every row, skips the bad ones and saves the rest in one write
+void Admin::importEvents() {
+    cout << "\n=== IMPORT EVENTS ===" << endl;
+    cout << "CSV columns: name,date,venue,capacity" << endl;
+    cout << "File path: ";
+    
+    string path;
+    getline(cin, path);
+    path = trim(path);
+    if (path.empty()) {
+        cout << "Error: File path cannot be empty!" << endl;
+        return;
+    }
+    
+    ::importEvents(path, EventStore::instance()).print();
+}
+
+// Enroll a whole class in an event (batch registration)
+// What it does: Takes an event and a list of usernames, drops the ones that are not
+// student accounts and registers the rest with one store call: capacity is checked
+// once and the batch is saved with a single write. If the event fills up part-way,
+// the students who got a seat stay registered and the rest are listed
+void Admin::enrollClass() {
+    cout << "\n=== ENROLL A CLASS ===" << endl;
+    
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    vector<Event>& events = store.getEvents();
+    if (events.empty()) {
+        cout << "No events available!" << endl;
+        return;
+    }
+    
+    viewAllEvents();
+    
+    cout << "Enter event number (0 to cancel): ";
+    int eventNum;
+    cin >> eventNum;
+    cin.ignore();
+    
+    if (eventNum < 1 || eventNum > (int)events.size()) {
+        cout << "Invalid selection!" << endl;
+        return;
+    }
+    string eventName = events[eventNum - 1].getEventName();
+    
+    cout << "Usernames (separated by commas or spaces): ";
+    string line;
+    getline(cin, line);
+    replace(line.begin(), line.end(), ',', ' ');
+    
+    // Only existing student accounts are enrolled
+    UserDirectory& directory = UserDirectory::instance();
+    directory.refresh();
+    vector<string> usernames;
+    stringstream words(line);
+    string username;
+    while (words >> username) {
+        const UserRecord* user = directory.find(username);
+        if (user == nullptr || user->userType != "student") {
+            cout << "  " << username << ": not a student account (skipped)" << endl;
+        } else {
+            usernames.push_back(username);
+        }
+    }
+    if (usernames.empty()) {
+        cout << "Error: No students to enroll!" << endl;
+        return;
+    }
+    
+    vector<RegistrationStatus> statuses = store.registerStudents(eventName, usernames, currentDateTime());
+    
+    size_t registered = 0, full = 0;
+    for (size_t i = 0; i < usernames.size(); i++) {
+        if (statuses[i] == REGISTRATION_OK) {
+            registered++;
+        } else {
+            if (statuses[i] == REGISTRATION_FULL) full++;
+            cout << "  " << usernames[i] << ": " << registrationStatusMessage(statuses[i]) << endl;
+        }
+    }
+    
+    cout << "Registered " << registered << " of " << usernames.size() << " student(s) for "
+         << eventName << "." << endl;
+    if (full > 0) {
+        cout << "The event filled up: " << full << " student(s) could not get a seat." << endl;
+    }
+}
+
 // Add new event (CREATE operation)
 // What it does: Gets event details from admin and adds it to the system
 // Input validation: Checks for empty fields, duplicate names, valid date format
@@ -225,7 +204,9 @@ void Admin::addNewEvent() {
     }
     
     // Check for duplicate event names
-    vector<Event> events = loadEventsFromFile();  // Load existing events
+    EventStore& store = EventStore::instance();   // Shared in-memory data
+    store.refresh();                              // Pick up any outside changes
+    const vector<Event>& events = store.getEvents();    // Reference - no copy
     for (const auto& e : events) {
         // Case-insensitive comparison using toLower()
         if (toLower(e.getEventName()) == toLower(eventName)) {
@@ -264,12 +245,13 @@ void Admin::addNewEvent() {
         return;
     }
     
-    // All validations passed - add new event to vector
+    // All validations passed - add new event (also indexes it for search)
     // Last parameter (0) means 0 students registered initially
-    events.push_back(Event(eventName, date, venue, capacity, 0));
+    store.addEvent(Event(eventName, date, venue, capacity, 0));
+    store.markEventsModified();
     
-    // Save updated vector back to file
-    if (saveEventsToFile(events)) {
+    // Save updated events back to file
+    if (store.save()) {
         cout << "\nSuccess! Event '" << eventName << "' added successfully!" << endl;
     } else {
         cout << "Error: Failed to save event!" << endl;
@@ -280,7 +262,9 @@ void Admin::addNewEvent() {
 void Admin::editEvent() {
     cout << "\n=== EDIT EVENT ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    vector<Event>& events = store.getEvents();
     if (events.empty()) {
         cout << "No events to edit!" << endl;
         return;
@@ -332,7 +316,8 @@ void Admin::editEvent() {
                 if (duplicate) {
                     cout << "Error: Event with this name already exists!" << endl;
                 } else {
-                    event.setEventName(newName);
+                    // Registrations follow the rename (they store the event's ID)
+                    store.renameEvent(event, newName);
                     cout << "Name updated successfully!" << endl;
                 }
             }
@@ -345,7 +330,7 @@ void Admin::editEvent() {
             newDate = trim(newDate);
             
             if (isValidDate(newDate)) {
-                event.setDate(newDate);
+                store.setEventDate(event, newDate);    // Moves it in the date index
                 cout << "Date updated successfully!" << endl;
             } else {
                 cout << "Error: Invalid date format!" << endl;
@@ -359,7 +344,7 @@ void Admin::editEvent() {
             newVenue = trim(newVenue);
             
             if (!newVenue.empty()) {
-                event.setVenue(newVenue);
+                store.setEventVenue(event, newVenue);    // Re-indexes it for search
                 cout << "Venue updated successfully!" << endl;
             }
             break;
@@ -375,6 +360,12 @@ void Admin::editEvent() {
             } else if (newCapacity > 0) {
                 event.setCapacity(newCapacity);
                 cout << "Capacity updated successfully!" << endl;
+                
+                // New seats go to the waitlist first (in the order students joined)
+                size_t promoted = store.promoteWaiters(event.getEventName());
+                if (promoted > 0) {
+                    cout << promoted << " student(s) moved from the waitlist into the event." << endl;
+                }
             } else {
                 cout << "Error: Capacity must be greater than 0!" << endl;
             }
@@ -388,7 +379,8 @@ void Admin::editEvent() {
     }
     
     if (choice >= 1 && choice <= 4) {
-        if (saveEventsToFile(events)) {
+        store.markEventsModified();
+        if (store.save()) {
             cout << "Changes saved successfully!" << endl;
         } else {
             cout << "Error: Failed to save changes!" << endl;
@@ -400,7 +392,9 @@ void Admin::editEvent() {
 void Admin::deleteEvent() {
     cout << "\n=== DELETE EVENT ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    vector<Event>& events = store.getEvents();
     if (events.empty()) {
         cout << "No events to delete!" << endl;
         return;
@@ -427,24 +421,12 @@ void Admin::deleteEvent() {
     
     if (toLower(trim(confirmation)) == "yes") {
         string deletedEventName = events[eventNum - 1].getEventName();
-        events.erase(events.begin() + eventNum - 1);
+        size_t registrationCount = store.getRegistrations().countForEvent(deletedEventName);
         
-        if (saveEventsToFile(events)) {
-            vector<Registration> registrations = loadRegistrationsFromFile();
-            vector<Registration> updatedRegistrations;
-            
-            // Loop through all registrations and keep only those not matching the deleted event
-            for (const auto& reg : registrations) {
-                if (reg.getEventName() != deletedEventName) {
-                    updatedRegistrations.push_back(reg);
-                }
-            }
-            
-            // Replace the original vector with the filtered one
-            registrations = updatedRegistrations;
-            saveRegistrationsToFile(registrations);
-            
-            cout << "Event deleted successfully!" << endl;
+        // One journal record; only this event's registrations are touched (posting list)
+        if (store.deleteEvent(deletedEventName)) {
+            cout << "Event deleted successfully! (" << registrationCount
+                 << " registration(s) removed)" << endl;
         } else {
             cout << "Error: Failed to delete event!" << endl;
         }
@@ -455,7 +437,9 @@ void Admin::deleteEvent() {
 
 // Admin functionality: Read and display events from file
 void Admin::viewAllEvents() {
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    const vector<Event>& events = store.getEvents();
     
     cout << "\n=== ALL EVENTS ===" << endl;
     
@@ -483,33 +467,42 @@ void Admin::viewAllEvents() {
 
 // Display event statistics
 void Admin::displayEventStats() {
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    const vector<Event>& events = store.getEvents();
     
     cout << "\n=== EVENT STATISTICS ===" << endl;
     
-    int totalEvents = events.size();
-    int totalCapacity = 0;
-    int totalRegistered = 0;
-    
-    for (const auto& event : events) {
-        totalCapacity += event.getCapacity();
-        totalRegistered += event.getRegisteredCount();
-    }
+    // Same counts as the registration summary report (see report.cpp)
+    RegistrationSummary summary = buildRegistrationSummary(events, store.getRegistrations());
     
-    cout << "Total Events: " << totalEvents << endl;
-    cout << "Total Capacity: " << totalCapacity << endl;
-    cout << "Total Registrations: " << totalRegistered << endl;
+    cout << "Total Events: " << summary.events.size() << endl;
+    cout << "Total Capacity: " << summary.totalCapacity << endl;
+    cout << "Total Registrations: " << summary.totalRegistered << endl;
     cout << "Overall Occupancy: " << fixed << setprecision(1) 
-         << (totalCapacity > 0 ? (totalRegistered * 100.0 / totalCapacity) : 0) << "%" << endl;
+         << summary.occupancy() << "%" << endl;
     
     cout << "\nEvent-wise Breakdown:" << endl;
     cout << "-------------------------------------------" << endl;
-    for (const auto& event : events) {
-        cout << event.getEventName() << ": " << event.getRegisteredCount() 
-             << "/" << event.getCapacity() << " (" << fixed << setprecision(1)
-             << (event.getCapacity() > 0 ? (event.getRegisteredCount() * 100.0 / event.getCapacity()) : 0) 
-             << "%)" << endl;
+    for (const auto& row : summary.events) {
+        cout << row.eventName << ": " << row.registered 
+             << "/" << row.capacity << " (" << fixed << setprecision(1)
+             << row.occupancy() << "%)" << endl;
+    }
+    
+    // Busiest hours, from the per-hour buckets of the registration timestamps
+    vector<HourlyCount> hours = buildHourlyRegistrations(store.getRegistrations());
+    if (!hours.empty()) {
+        stable_sort(hours.begin(), hours.end(), [](const HourlyCount& a, const HourlyCount& b) {
+            return a.registrations > b.registrations;
+        });
+        cout << "\nBusiest Registration Hours:" << endl;
+        cout << "-------------------------------------------" << endl;
+        for (size_t i = 0; i < hours.size() && i < 5; i++) {
+            cout << formatTimestamp(hours[i].hourStart) << " - "
+                 << formatTimestamp(hours[i].hourStart + 59).substr(11)
+                 << ": " << hours[i].registrations << " registration(s)" << endl;
+        }
     }
 }
 
@@ -517,8 +510,10 @@ void Admin::displayEventStats() {
 void Admin::viewRegistrationReports() {
     cout << "\n=== REGISTRATION REPORTS ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    const vector<Event>& events = store.getEvents();
+    const RegistrationIndex& registrations = store.getRegistrations();
     
     if (events.empty()) {
         cout << "No events in the system!" << endl;
@@ -535,25 +530,19 @@ void Admin::viewRegistrationReports() {
     
     if (choice == 0) {
         cout << "\n=== REGISTRATION SUMMARY ===" << endl;
-        for (const auto& event : events) {
-            int count = 0;
-            for (const auto& reg : registrations) {
-                if (reg.getEventName() == event.getEventName()) {
-                    count++;
-                }
-            }
-            cout << event.getEventName() << ": " << count << " registrations" << endl;
+        RegistrationSummary summary = buildRegistrationSummary(events, registrations);
+        for (const auto& row : summary.events) {
+            cout << row.eventName << ": " << row.registered << " registrations" << endl;
         }
     } else if (choice >= 1 && choice <= (int)events.size()) {
         string eventName = events[choice - 1].getEventName();
         cout << "\n=== PARTICIPANTS FOR: " << eventName << " ===" << endl;
         
+        // Walk only this event's posting list
         int count = 0;
-        for (const auto& reg : registrations) {
-            if (reg.getEventName() == eventName) {
-                cout << "  " << ++count << ". " << reg.getStudentUsername() 
-                     << " (Registered: " << reg.getRegistrationDate() << ")" << endl;
-            }
+        for (const Registration& reg : registrations.forEvent(eventName)) {
+            cout << "  " << ++count << ". " << reg.getStudentUsername() 
+                 << " (Registered: " << reg.getRegistrationDate() << ")" << endl;
         }
         
         if (count == 0) {
@@ -561,6 +550,15 @@ void Admin::viewRegistrationReports() {
         } else {
             cout << "\nTotal Participants: " << count << endl;
         }
+        
+        vector<Registration> waiting = registrations.waitlistForEvent(eventName);
+        if (!waiting.empty()) {
+            cout << "\nWaitlist (" << waiting.size() << "):" << endl;
+            for (size_t i = 0; i < waiting.size(); i++) {
+                cout << "  " << i + 1 << ". " << waiting[i].getStudentUsername()
+                     << " (Joined: " << waiting[i].getRegistrationDate() << ")" << endl;
+            }
+        }
     } else {
         cout << "Invalid selection!" << endl;
     }
@@ -571,7 +569,9 @@ void Admin::manageUsers() {
     cout << "\n=== USER MANAGEMENT ===" << endl;
     cout << "1. Add New Student" << endl;
     cout << "2. View All Users" << endl;
-    cout << "3. Back" << endl;
+    cout << "3. Hash Plaintext Passwords" << endl;
+    cout << "4. Import Students from CSV" << endl;
+    cout << "5. Back" << endl;
     cout << "Choose option: ";
     
     int choice;
@@ -586,12 +586,36 @@ void Admin::manageUsers() {
             viewAllUsers();
             break;
         case 3:
+            migratePasswords();
+            break;
+        case 4:
+            importStudents();
+            break;
+        case 5:
             break;
         default:
             cout << "Invalid choice!" << endl;
     }
 }
 
+// Import student accounts from a CSV file
+// What it does: Same as importEvents() for users.txt; passwords are hashed on import
+void Admin::importStudents() {
+    cout << "\n=== IMPORT STUDENTS ===" << endl;
+    cout << "CSV columns: username,password,full name" << endl;
+    cout << "File path: ";
+    
+    string path;
+    getline(cin, path);
+    path = trim(path);
+    if (path.empty()) {
+        cout << "Error: File path cannot be empty!" << endl;
+        return;
+    }
+    
+    ::importStudents(path, UserDirectory::instance()).print();
+}
+
 // Add new student account
 void Admin::addNewStudent() {
     cout << "\n=== ADD NEW STUDENT ===" << endl;
@@ -607,19 +631,13 @@ void Admin::addNewStudent() {
         return;
     }
     
-    // Check if username exists
-    ifstream file("data/users.txt");
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        vector<string> parts = split(line, ',');
-        if (parts.size() > 0 && trim(parts[0]) == username) {
-            cout << "Error: Username already exists!" << endl;
-            file.close();
-            return;
-        }
+    // Check if username exists (O(1) lookup in the user directory)
+    UserDirectory& directory = UserDirectory::instance();
+    directory.refresh();
+    if (directory.contains(username)) {
+        cout << "Error: Username already exists!" << endl;
+        return;
     }
-    file.close();
     
     cout << "Password: ";
     getline(cin, password);
@@ -638,16 +656,17 @@ void Admin::addNewStudent() {
         return;
     }
     
-    // Append to users.txt
-    ofstream outfile("data/users.txt", ios::app);
-    if (!outfile.is_open()) {
-        cout << "Error: Could not open users.txt for writing!" << endl;
+    // Append to users.txt (and to the directory)
+    directory.refresh();
+    // Only the salted hash is stored, never the password itself
+    string stored = VerifierPool::instance().hash(password).get();
+    if (!directory.addUser(UserRecord{username, stored, fullName, "student"})) {
+        if (directory.contains(username)) {
+            cout << "Error: Username already exists!" << endl;
+        }
         return;
     }
     
-    outfile << username << "," << password << "," << fullName << ",student" << endl;
-    outfile.close();
-    
     cout << "Success! Student account created successfully!" << endl;
 }
 
@@ -655,28 +674,37 @@ void Admin::addNewStudent() {
 void Admin::viewAllUsers() {
     cout << "\n=== ALL USERS ===" << endl;
     
-    ifstream file("data/users.txt");
-    string line;
+    UserDirectory& directory = UserDirectory::instance();
     int count = 0;
     
-    if (!file.is_open()) {
+    if (!directory.refresh()) {
         cout << "Error: Could not open users.txt!" << endl;
         return;
     }
     
     cout << "====================================" << endl;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        vector<string> parts = split(line, ',');
-        if (parts.size() >= 4) {
-            cout << ++count << ". Username: " << trim(parts[0]) 
-                 << " | Name: " << trim(parts[2]) 
-                 << " | Type: " << trim(parts[3]) << endl;
-        }
+    for (const auto& user : directory.getUsers()) {
+        cout << ++count << ". Username: " << user.username 
+             << " | Name: " << user.fullName 
+             << " | Type: " << user.userType << endl;
     }
     cout << "====================================" << endl;
     cout << "Total Users: " << count << endl;
+}
+
+// Hash every plaintext password in users.txt
+// What it does: Bulk migration to the hashed format; otherwise each plaintext entry
+// is only upgraded when its user next logs in
+void Admin::migratePasswords() {
+    cout << "\n=== HASH PLAINTEXT PASSWORDS ===" << endl;
+    
+    UserDirectory& directory = UserDirectory::instance();
+    if (!directory.refresh()) {
+        cout << "Error: Could not open users.txt!" << endl;
+        return;
+    }
     
-    file.close();
+    size_t migrated = directory.migratePasswords();
+    cout << "Success! " << migrated << " password(s) hashed (cost: " 
+         << getPasswordCost() << " iterations)." << endl;
 }
@@ -0,0 +1,419 @@
+#include "cli.h"
+#include "eventstore.h"
+#include "userdirectory.h"
+#include "importer.h"
+#include "report.h"
+#include "snapshot.h"
+#include "utils.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+
+// ========================================
+// CLI.CPP - Command Line Mode Implementation
+// ========================================
+// This file implements the subcommands described in cli.h. Every command is a thin
+// wrapper: parse the options, call the store / directory / report engine exactly as
+// the menus do, and print the result.
+
+// ==================== ARGUMENTS ====================
+
+// The words after the subcommand: "--name value" options, "--flag" switches and
+// plain (positional) words
+struct CliArguments {
+    vector<string> words;
+    unordered_map<string, string> options;
+
+    bool has(const string& name) const {
+        return options.count(name) > 0;
+    }
+
+    // Value of an option ("" if it was not given)
+    string get(const string& name) const {
+        auto it = options.find(name);
+        return it == options.end() ? "" : it->second;
+    }
+};
+
+// Switches that never take a value
+static bool isFlag(const string& name) {
+    return name == "json";
+}
+
+// Split argv[2..] into words and options
+static CliArguments parseArguments(int argc, char* argv[]) {
+    CliArguments arguments;
+    for (int i = 2; i < argc; i++) {
+        string word = argv[i];
+        if (word.size() > 2 && word.compare(0, 2, "--") == 0) {
+            string name = word.substr(2);
+            if (!isFlag(name) && i + 1 < argc) {
+                arguments.options[name] = argv[++i];
+            } else {
+                arguments.options[name] = "";
+            }
+        } else {
+            arguments.words.push_back(word);
+        }
+    }
+    return arguments;
+}
+
+// Print an error and return the failure exit code
+static int fail(const string& message) {
+    cerr << "Error: " << message << endl;
+    return 1;
+}
+
+// Check that the required options are present
+static bool requireOptions(const CliArguments& arguments, const vector<string>& names) {
+    for (const auto& name : names) {
+        if (trim(arguments.get(name)).empty()) {
+            cerr << "Error: Missing --" << name << " (see 'event-management help')" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== JSON OUTPUT ====================
+
+// A JSON string literal (quotes, backslashes and control characters escaped)
+static string jsonString(const string& text) {
+    string result = "\"";
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += (char)c;
+        } else if (c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        } else {
+            result += (char)c;
+        }
+    }
+    return result + "\"";
+}
+
+// A percentage with one decimal, as in the statistics screen
+static string jsonPercent(double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f", value);
+    return buffer;
+}
+
+static string eventJson(const Event& event) {
+    return "{\"name\": " + jsonString(event.getEventName()) + ", \"date\": " + jsonString(event.getDate()) +
+           ", \"venue\": " + jsonString(event.getVenue()) + ", \"capacity\": " + to_string(event.getCapacity()) +
+           ", \"registered\": " + to_string(event.getRegisteredCount()) + "}";
+}
+
+// Print objects as a JSON array, one element per line
+static void printJsonArray(const vector<string>& elements) {
+    cout << "[";
+    for (size_t i = 0; i < elements.size(); i++) {
+        cout << (i == 0 ? "\n  " : ",\n  ") << elements[i];
+    }
+    cout << (elements.empty() ? "]" : "\n]") << endl;
+}
+
+// Print a list of events as JSON or as name|date|venue|capacity|registered lines
+static void printEvents(const vector<const Event*>& events, bool json) {
+    if (json) {
+        vector<string> elements;
+        for (const Event* event : events) elements.push_back(eventJson(*event));
+        printJsonArray(elements);
+        return;
+    }
+    for (const Event* event : events) {
+        cout << event->getEventName() << "|" << event->getDate() << "|" << event->getVenue() << "|"
+             << event->getCapacity() << "|" << event->getRegisteredCount() << endl;
+    }
+}
+
+// ==================== COMMANDS ====================
+
+// The shared store, loaded. Diagnostics go to stderr so stdout stays parseable
+// (e.g. the JSON of --json); repaired seat counts are saved right away
+static EventStore& loadedStore() {
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    size_t rebuilt = store.takeRebuiltCounts();
+    if (rebuilt > 0) {
+        cerr << "Note: Registration counts of " << rebuilt
+             << " event(s) did not match their registrations and were rebuilt." << endl;
+        store.save();
+    }
+    return store;
+}
+
+// Only student accounts can be registered (same rule as logging in as a Student)
+static bool isStudent(const string& username) {
+    UserDirectory& directory = UserDirectory::instance();
+    directory.refresh();
+    const UserRecord* user = directory.find(username);
+    return user != nullptr && user->userType == "student";
+}
+
+// list-events [--json]
+static int listEvents(const CliArguments& arguments) {
+    EventStore& store = loadedStore();
+    auto guard = store.readLock();
+    vector<const Event*> events;
+    for (const auto& event : store.getEvents()) events.push_back(&event);
+    printEvents(events, arguments.has("json"));
+    return 0;
+}
+
+// search --query <text> [--json]
+// Name matches first, then venue-only matches (as in the student search screen)
+static int searchEvents(const CliArguments& arguments) {
+    if (!requireOptions(arguments, {"query"})) return 1;
+
+    EventStore& store = loadedStore();    // searchEvents() takes the read lock itself
+    string query = trim(arguments.get("query"));
+    vector<const Event*> results;
+    for (Event* event : store.searchEvents(query, SEARCH_NAME)) results.push_back(event);
+    for (Event* event : store.searchEvents(query, SEARCH_VENUE)) {
+        if (find(results.begin(), results.end(), event) == results.end()) results.push_back(event);
+    }
+    printEvents(results, arguments.has("json"));
+    return 0;
+}
+
+// register --user <username> --event <name>
+static int registerStudent(const CliArguments& arguments) {
+    if (!requireOptions(arguments, {"user", "event"})) return 1;
+    string username = trim(arguments.get("user"));
+    string eventName = trim(arguments.get("event"));
+    if (!isStudent(username)) return fail("'" + username + "' is not a student account");
+
+    RegistrationStatus status = loadedStore().registerStudent(username, eventName, currentDateTime());
+    if (status != REGISTRATION_OK) return fail(registrationStatusMessage(status));
+    cout << "Registered " << username << " for " << eventName << "." << endl;
+    return 0;
+}
+
+// unregister --user <username> --event <name>
+static int unregisterStudent(const CliArguments& arguments) {
+    if (!requireOptions(arguments, {"user", "event"})) return 1;
+    string username = trim(arguments.get("user"));
+    string eventName = trim(arguments.get("event"));
+
+    RegistrationStatus status = loadedStore().unregisterStudent(username, eventName);
+    if (status != REGISTRATION_OK) return fail(registrationStatusMessage(status));
+    cout << "Unregistered " << username << " from " << eventName << "." << endl;
+    return 0;
+}
+
+// enroll --event <name> --users <u1,u2,...>
+// Prints one line per student who was not registered; fails unless all were
+static int enrollStudents(const CliArguments& arguments) {
+    if (!requireOptions(arguments, {"event", "users"})) return 1;
+    string eventName = trim(arguments.get("event"));
+
+    string list = arguments.get("users");
+    replace(list.begin(), list.end(), ',', ' ');
+    stringstream words(list);
+    vector<string> usernames;
+    string username;
+    bool allStudents = true;
+    while (words >> username) {
+        if (isStudent(username)) {
+            usernames.push_back(username);
+        } else {
+            cout << username << ": not a student account" << endl;
+            allStudents = false;
+        }
+    }
+
+    vector<RegistrationStatus> statuses = loadedStore().registerStudents(eventName, usernames, currentDateTime());
+    size_t registered = 0;
+    for (size_t i = 0; i < usernames.size(); i++) {
+        if (statuses[i] == REGISTRATION_OK) {
+            registered++;
+        } else {
+            cout << usernames[i] << ": " << registrationStatusMessage(statuses[i]) << endl;
+        }
+    }
+    cout << "Registered " << registered << " of " << usernames.size() << " student(s) for "
+         << eventName << "." << endl;
+    return allStudents && registered == usernames.size() ? 0 : 1;
+}
+
+// my-registrations --user <username> [--json]
+static int myRegistrations(const CliArguments& arguments) {
+    if (!requireOptions(arguments, {"user"})) return 1;
+
+    EventStore& store = loadedStore();
+    auto guard = store.readLock();
+    vector<Registration> registrations = store.getRegistrations().forStudent(trim(arguments.get("user")));
+    if (arguments.has("json")) {
+        vector<string> elements;
+        for (const auto& reg : registrations) {
+            elements.push_back("{\"event\": " + jsonString(reg.getEventName()) + ", \"registeredAt\": " +
+                               jsonString(reg.getRegistrationDate()) + "}");
+        }
+        printJsonArray(elements);
+        return 0;
+    }
+    for (const auto& reg : registrations) {
+        cout << reg.getEventName() << "|" << reg.getRegistrationDate() << endl;
+    }
+    return 0;
+}
+
+// report summary [--json] / report participants --event <name> [--json]
+static int report(const CliArguments& arguments) {
+    string kind = arguments.words.empty() ? "" : arguments.words[0];
+    bool json = arguments.has("json");
+    EventStore& store = loadedStore();
+    auto guard = store.readLock();
+
+    if (kind == "summary") {
+        RegistrationSummary summary = buildRegistrationSummary(store.getEvents(), store.getRegistrations());
+        if (json) {
+            vector<string> rows;
+            for (const auto& row : summary.events) {
+                rows.push_back("{\"event\": " + jsonString(row.eventName) + ", \"capacity\": " +
+                               to_string(row.capacity) + ", \"registered\": " + to_string(row.registered) +
+                               ", \"occupancy\": " + jsonPercent(row.occupancy()) + "}");
+            }
+            cout << "{\"totalCapacity\": " << summary.totalCapacity << ", \"totalRegistered\": "
+                 << summary.totalRegistered << ", \"occupancy\": " << jsonPercent(summary.occupancy())
+                 << ", \"events\": ";
+            printJsonArray(rows);
+            cout << "}" << endl;
+            return 0;
+        }
+        for (const auto& row : summary.events) {
+            cout << row.eventName << "|" << row.capacity << "|" << row.registered << "|"
+                 << jsonPercent(row.occupancy()) << endl;
+        }
+        cout << "TOTAL|" << summary.totalCapacity << "|" << summary.totalRegistered << "|"
+             << jsonPercent(summary.occupancy()) << endl;
+        return 0;
+    }
+
+    if (kind == "participants") {
+        if (!requireOptions(arguments, {"event"})) return 1;
+        string eventName = trim(arguments.get("event"));
+        if (store.findEvent(eventName) == nullptr) return fail("no such event");
+
+        vector<Registration> participants = store.getRegistrations().forEvent(eventName);
+        if (json) {
+            vector<string> elements;
+            for (const auto& reg : participants) {
+                elements.push_back("{\"username\": " + jsonString(reg.getStudentUsername()) +
+                                   ", \"registeredAt\": " + jsonString(reg.getRegistrationDate()) + "}");
+            }
+            printJsonArray(elements);
+            return 0;
+        }
+        for (const auto& reg : participants) {
+            cout << reg.getStudentUsername() << "|" << reg.getRegistrationDate() << endl;
+        }
+        return 0;
+    }
+
+    return fail("Unknown report (use 'report summary' or 'report participants --event <name>')");
+}
+
+// import events|students <file.csv>
+static int importFile(const CliArguments& arguments) {
+    string kind = arguments.words.size() >= 1 ? arguments.words[0] : "";
+    string path = arguments.words.size() >= 2 ? arguments.words[1] : "";
+    if ((kind != "events" && kind != "students") || path.empty()) {
+        cerr << "Usage: event-management import events|students <file.csv>" << endl;
+        return 1;
+    }
+
+    ImportReport result = kind == "events" ? importEvents(path, loadedStore())
+                                           : importStudents(path, UserDirectory::instance());
+    result.print();
+    return result.fileRead && result.committed && result.errors.empty() ? 0 : 1;
+}
+
+// snapshot enable|disable
+// snapshot to-binary <events.txt> <registrations.txt> <snapshot.bin>
+// snapshot to-text <snapshot.bin> <events.txt> <registrations.txt>
+// enable/disable switch the store's binary snapshot (data/snapshot.bin) on or off;
+// to-binary / to-text convert between the two formats without touching the store
+static int snapshot(const CliArguments& arguments) {
+    string kind = arguments.words.empty() ? "" : arguments.words[0];
+    const vector<string>& w = arguments.words;
+
+    if (kind == "enable" || kind == "disable") {
+        if (!loadedStore().setBinarySnapshot(kind == "enable")) return fail("Could not update the binary snapshot");
+        cout << "Binary snapshot " << (kind == "enable" ? "enabled" : "disabled") << "." << endl;
+        return 0;
+    }
+    if (kind == "to-binary" && w.size() == 4) {
+        if (!convertTextToSnapshot(w[1], w[2], w[3])) return fail("Could not convert the text files");
+        cout << "Wrote " << w[3] << "." << endl;
+        return 0;
+    }
+    if (kind == "to-text" && w.size() == 4) {
+        if (!convertSnapshotToText(w[1], w[2], w[3])) return fail("Could not convert " + w[1]);
+        cout << "Wrote " << w[2] << " and " << w[3] << "." << endl;
+        return 0;
+    }
+
+    cerr << "Usage: event-management snapshot enable|disable" << endl;
+    cerr << "       event-management snapshot to-binary <events.txt> <registrations.txt> <snapshot.bin>" << endl;
+    cerr << "       event-management snapshot to-text <snapshot.bin> <events.txt> <registrations.txt>" << endl;
+    return 1;
+}
+
+static int printHelp(const CliArguments&) {
+    cout << "Usage: event-management [command] [options]" << endl;
+    cout << "  (no command)                                  interactive menus" << endl;
+    cout << "  --server [socket path]                        multi-client server mode" << endl;
+    cout << "  list-events [--json]" << endl;
+    cout << "  search --query <text> [--json]" << endl;
+    cout << "  register --user <username> --event <name>" << endl;
+    cout << "  unregister --user <username> --event <name>" << endl;
+    cout << "  enroll --event <name> --users <u1,u2,...>" << endl;
+    cout << "  my-registrations --user <username> [--json]" << endl;
+    cout << "  report summary [--json]" << endl;
+    cout << "  report participants --event <name> [--json]" << endl;
+    cout << "  import events|students <file.csv>" << endl;
+    cout << "  snapshot enable|disable" << endl;
+    cout << "  snapshot to-binary <events.txt> <registrations.txt> <snapshot.bin>" << endl;
+    cout << "  snapshot to-text <snapshot.bin> <events.txt> <registrations.txt>" << endl;
+    return 0;
+}
+
+// ==================== DISPATCH ====================
+
+typedef int (*CliHandler)(const CliArguments&);
+
+static const unordered_map<string, CliHandler>& commands() {
+    static const unordered_map<string, CliHandler> table = {
+        {"list-events", listEvents},
+        {"search", searchEvents},
+        {"register", registerStudent},
+        {"unregister", unregisterStudent},
+        {"enroll", enrollStudents},
+        {"my-registrations", myRegistrations},
+        {"report", report},
+        {"import", importFile},
+        {"snapshot", snapshot},
+        {"help", printHelp},
+    };
+    return table;
+}
+
+bool isCliCommand(const string& name) {
+    return commands().count(name) > 0;
+}
+
+int runCliCommand(int argc, char* argv[]) {
+    if (argc < 2 || !isCliCommand(argv[1])) return printHelp(CliArguments()) + 1;
+    return commands().at(argv[1])(parseArguments(argc, argv));
+}
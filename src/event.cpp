@@ -1,4 +1,6 @@
 #include "event.h"
+#include "utils.h"
+#include <algorithm>  // For min()
 #include <iomanip>    // For formatting output (setw, setprecision, etc.)
 
 // ========================================
@@ -14,21 +16,50 @@
 Event::Event(string name, string d, string v, int cap, int reg)
     : eventName(name),           // Initialize event name
       date(d),                   // Initialize date
+      day(dayNumber(d)),         // Parse the date once, for sorting and range queries
       venue(v),                  // Initialize venue
       capacity(cap),             // Initialize maximum capacity
       registeredCount(reg) {}    // Initialize current registration count
 
+// Copy constructor
+// What it does: Copies the strings and takes a snapshot of the two atomic counters
+// (std::atomic has no copy constructor, so the default one does not exist)
+Event::Event(const Event& other)
+    : eventName(other.eventName),
+      date(other.date),
+      day(other.day),
+      venue(other.venue),
+      capacity(other.capacity.load()),
+      registeredCount(other.registeredCount.load()) {}
+
+// Copy assignment - same snapshot as the copy constructor
+Event& Event::operator=(const Event& other) {
+    if (this != &other) {
+        eventName = other.eventName;
+        date = other.date;
+        day = other.day;
+        venue = other.venue;
+        capacity.store(other.capacity.load());
+        registeredCount.store(other.registeredCount.load());
+    }
+    return *this;
+}
+
 // Getter methods - Provide read-only access to private member variables
 // 'const' at the end means these functions don't modify the object (they're read-only)
-string Event::getEventName() const { 
+const string& Event::getEventName() const { 
     return eventName;            // Return the name of the event
 }
 
-string Event::getDate() const { 
+const string& Event::getDate() const { 
     return date;                 // Return the date (DD-MM-YYYY format)
 }
 
-string Event::getVenue() const { 
+int32_t Event::getDayNumber() const {
+    return day;                  // Days since 01-01-1970 (INVALID_DAY if the date is malformed)
+}
+
+const string& Event::getVenue() const { 
     return venue;                // Return where the event is held
 }
 
@@ -52,6 +83,7 @@ void Event::setEventName(const string& name) {
 
 void Event::setDate(const string& d) { 
     date = d;                    // Update event date
+    day = dayNumber(d);          // ...and its day number
 }
 
 void Event::setVenue(const string& v) { 
@@ -73,22 +105,63 @@ bool Event::hasAvailableSeats() const {
     return registeredCount < capacity;   // True if registrations haven't reached capacity
 }
 
-// Increment registered count when a student registers
-// What it does: Increases the registration count by 1 (if space available)
-// Safety check: Only increments if seats are available
-void Event::registerStudent() {
-    if (hasAvailableSeats()) {           // Check if there's space
-        registeredCount++;               // Increase count by 1
+// Reserve a seat
+// What it does: Compare-and-swap loop: read the count, and only if it is below
+// capacity try to replace it with count + 1. If another thread changed the count
+// in between, compare_exchange_weak fails, reloads the current value into
+// 'current' and we try again - so no seat is ever handed out twice, without a lock
+bool Event::tryReserveSeat() {
+    int current = registeredCount.load(memory_order_relaxed);
+    while (current < capacity.load(memory_order_relaxed)) {
+        if (registeredCount.compare_exchange_weak(current, current + 1, memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reserve seats for a batch
+// What it does: Same CAS loop as tryReserveSeat(), but claims min(wanted, seats left)
+// in one step, so a batch checks the capacity once instead of once per student
+int Event::tryReserveSeats(int wanted) {
+    int current = registeredCount.load(memory_order_relaxed);
+    while (true) {
+        int granted = min(wanted, capacity.load(memory_order_relaxed) - current);
+        if (granted <= 0) return 0;
+        if (registeredCount.compare_exchange_weak(current, current + granted, memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            return granted;
+        }
     }
 }
 
+// Release a seat (same CAS loop, bounded below by 0)
+bool Event::releaseSeat() {
+    int current = registeredCount.load(memory_order_relaxed);
+    while (current > 0) {
+        if (registeredCount.compare_exchange_weak(current, current - 1, memory_order_acq_rel,
+                                                  memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Count a registration that has already been accepted
+// What it does: Increases the registration count by 1 without checking capacity.
+// New registrations take their seat with tryReserveSeat() instead; this is for a
+// registration the index already holds (e.g. one added by an admin), so the
+// count always equals the number of registrations in the index.
+void Event::registerStudent() {
+    registeredCount.fetch_add(1, memory_order_acq_rel);
+}
+
 // Decrement registered count when a student unregisters
 // What it does: Decreases the registration count by 1 (if any registrations exist)
 // Safety check: Only decrements if count is greater than 0
 void Event::unregisterStudent() {
-    if (registeredCount > 0) {           // Check if there are registrations to remove
-        registeredCount--;               // Decrease count by 1
-    }
+    releaseSeat();
 }
 
 // Format event data for file storage (pipe-delimited)
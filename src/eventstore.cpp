@@ -0,0 +1,1000 @@
+#include "eventstore.h"
+#include "snapshot.h"
+#include "mappedfile.h"
+
+// ========================================
+// EVENTSTORE.CPP - Shared Event Store Implementation
+// ========================================
+// This file implements the EventStore class, the single in-memory copy of
+// events.txt and registrations.txt shared by Admin and Student.
+// Files are parsed once, kept resident, re-read only when they change on disk,
+// and written back only when their data was modified.
+// Registration changes go to an append-only journal (registrations.log) that is
+// replayed at startup and compacted into the snapshot files in the background.
+#include <cstdio>
+#include <algorithm>
+
+// Constructor
+// What it does: Remembers where the data files live; nothing is read until first use
+// The binary snapshot is used if one already exists in the data folder
+EventStore::EventStore(const string& dataDir)
+    : eventsPath(dataDir + "/events.txt"),
+      registrationsPath(dataDir + "/registrations.txt"),
+      journalPath(dataDir + "/registrations.log"),
+      compactingPath(dataDir + "/registrations.log.compacting"),
+      binarySnapshotPath(dataDir + "/snapshot.bin"),
+      waitlistPath(dataDir + "/waitlist.txt"),
+      commitPath(dataDir + "/files.commit"),
+      journal(dataDir + "/registrations.log"),
+      journalRecords(0),
+      compactionThreshold(1000),
+      compactionDone(false),
+      journalRestampNeeded(false),
+      loaded(false),
+      eventsModified(false),
+      registrationsModified(false),
+      rebuiltCounts(0),
+      binarySnapshotEnabled(getFileStamp(dataDir + "/snapshot.bin").exists) {}
+
+// Destructor
+// What it does: Lets a running background compaction finish and flushes the log,
+// so nothing journaled is lost when the program exits
+EventStore::~EventStore() {
+    finishCompaction(true);
+    journal.close();
+}
+
+// The shared store
+// What it does: Returns the one EventStore used by the whole program
+// The static local is created the first time this is called
+EventStore& EventStore::instance() {
+    static EventStore store;
+    return store;
+}
+
+string registrationStatusMessage(RegistrationStatus status) {
+    switch (status) {
+        case REGISTRATION_OK:        return "ok";
+        case REGISTRATION_DUPLICATE: return "already registered";
+        case REGISTRATION_FULL:      return "event is full";
+        case REGISTRATION_NO_EVENT:  return "no such event";
+        case REGISTRATION_NOT_FOUND: return "not registered";
+        case REGISTRATION_WAITLISTED: return "added to the waitlist";
+        case REGISTRATION_ALREADY_WAITING: return "already on the waitlist";
+        default:                     return "could not save registration";
+    }
+}
+
+// ==================== FILE I/O OPERATIONS ====================
+
+// Load everything from disk
+// What it does: Reads the snapshot files (events.txt, registrations.txt - or the binary
+// snapshot.bin when it is enabled and up to date), then replays
+// the journal on top of them: first a log left over from an interrupted compaction,
+// then the live log. Replaying is idempotent, so a record that already made it
+// into the snapshot is simply skipped.
+bool EventStore::loadFromFiles() {
+    events.clear();
+    registrations.clear();
+    journal.close();
+    loaded = true;
+    eventsModified = false;
+    registrationsModified = false;
+
+    // ----- a writeDataFiles() cut short by a crash after its commit point -----
+    if (getFileStamp(commitPath).exists) {
+        finishCommit();
+    }
+
+    // ----- events.txt + registrations.txt (or the binary snapshot) -----
+    if (binarySnapshotIsFresh()) {
+        if (!readSnapshot(binarySnapshotPath, events, registrations)) {
+            events.clear();
+            registrations.clear();
+            readEventsFile(eventsPath, events);
+            readRegistrationsFile(registrationsPath, registrations);
+        }
+    } else {
+        readEventsFile(eventsPath, events);
+        readRegistrationsFile(registrationsPath, registrations);
+    }
+
+    // ----- waitlist.txt (not part of the binary snapshot) -----
+    readWaitlistFile(waitlistPath, registrations);
+
+    // ----- seat counts: derived from the registrations, not taken from disk -----
+    // Checked against the snapshot first: the journal has not reached the events.txt
+    // column yet, so only a mismatch here means the files disagree
+    rebuiltCounts = rebuildRegistrationCounts();
+    if (rebuiltCounts > 0) eventsModified = true;    // The next save() keeps the fix
+
+    // ----- registrations.log -----
+    auto apply = [this](string_view record) { applyJournalRecord(record); };
+    size_t leftover = Journal::replay(compactingPath, apply);
+    journalRecords = Journal::replay(journalPath, apply);
+
+    rebuildEventIndexes();
+    rebuildRegistrationCounts();
+
+    restampFiles();
+
+    // A compaction was interrupted - fold everything into the snapshot right away
+    if (leftover > 0) {
+        return compactNow();
+    }
+    return true;
+}
+
+// Rebuild every event's registration count from the index
+// What it does: One pass over the events, counting each one's registrations through
+// its posting list, and overwrites the count that came from the file
+// Returns: how many events had a count that disagreed with their registrations
+size_t EventStore::rebuildRegistrationCounts() {
+    size_t mismatched = 0;
+    for (auto& event : events) {
+        SymbolId id = eventSymbols().find(event.getEventName());
+        int actual = id == NO_SYMBOL ? 0 : (int)registrations.countForEvent(id);
+        if (event.getRegisteredCount() != actual) {
+            event.setRegisteredCount(actual);
+            mismatched++;
+        }
+    }
+    return mismatched;
+}
+
+// Read events.txt
+// File format: eventname|date|venue|capacity|registered
+bool EventStore::readEventsFile(const string& path, vector<Event>& events) {
+    // Lines come straight from the memory-mapped file and fields are views into
+    // them - nothing is copied until the Event itself is built
+    bool opened = forEachLine(path, [&events](string_view line) {
+        string_view fields[5];
+        size_t count = splitFields(line, '|', fields, 5);
+        int capacity = 0;
+        int registered = 0;
+        if (count >= 4 && parseInt(fields[3], capacity) &&
+            (count == 4 || parseInt(fields[4], registered))) {
+            events.push_back(Event(string(trimView(fields[0])), string(trimView(fields[1])),
+                                   string(trimView(fields[2])), capacity, registered));
+        }
+    });
+
+    if (!opened) {
+        cerr << "Error: Could not open events.txt file!" << endl;
+    }
+    return opened;
+}
+
+// Parse a date/time read back from a data file
+// What it does: Text that is not "DD-MM-YYYY HH:MM" becomes INVALID_TIMESTAMP (shown
+// blank) and is reported on stderr with the file it came from, so a bad entry is not
+// silently turned into some other time. Only the first few are reported
+static Timestamp parseStoredTimestamp(string_view text, const string& source) {
+    static atomic<int> reported(0);
+    const int maxReports = 10;
+
+    Timestamp timestamp = parseTimestamp(text);
+    if (timestamp == INVALID_TIMESTAMP && !text.empty() && reported++ < maxReports) {
+        cerr << "Warning: unreadable date/time '" << text << "' in " << source
+             << " (kept without a time)" << endl;
+    }
+    return timestamp;
+}
+
+// Read registrations.txt
+// File format: username|eventname|registrationdate
+// A missing file is not an error (no one has registered yet)
+bool EventStore::readRegistrationsFile(const string& path, RegistrationIndex& registrations) {
+    // Names are interned straight from the field views; only new names are copied
+    forEachLine(path, [&registrations, &path](string_view line) {
+        string_view fields[3];
+        if (splitFields(line, '|', fields, 3) == 3) {
+            registrations.add(Registration(userSymbols().intern(trimView(fields[0])),
+                                           eventSymbols().intern(trimView(fields[1])),
+                                           parseStoredTimestamp(trimView(fields[2]), path)));
+        }
+    });
+    return true;
+}
+
+// Read waitlist.txt
+// File format: username|eventname|joinedat, in waitlist order
+// A missing file is not an error (nobody is waiting)
+bool EventStore::readWaitlistFile(const string& path, RegistrationIndex& registrations) {
+    forEachLine(path, [&registrations, &path](string_view line) {
+        string_view fields[3];
+        if (splitFields(line, '|', fields, 3) == 3) {
+            registrations.addWaiter(Registration(userSymbols().intern(trimView(fields[0])),
+                                                 eventSymbols().intern(trimView(fields[1])),
+                                                 parseStoredTimestamp(trimView(fields[2]), path)));
+        }
+    });
+    return true;
+}
+
+// Is the binary snapshot usable?
+// It must be enabled, exist, and be at least as new as both text files
+// (a hand-edited events.txt or registrations.txt wins over an older snapshot)
+bool EventStore::binarySnapshotIsFresh() const {
+    if (!binarySnapshotEnabled) return false;
+
+    FileStamp snapshot = getFileStamp(binarySnapshotPath);
+    if (!snapshot.exists) return false;
+
+    for (const string& path : {eventsPath, registrationsPath}) {
+        FileStamp text = getFileStamp(path);
+        if (text.exists && (text.modifiedSec > snapshot.modifiedSec ||
+                            (text.modifiedSec == snapshot.modifiedSec &&
+                             text.modifiedNsec > snapshot.modifiedNsec))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Write "<path>.tmp" with one line per item (not yet flushed or renamed)
+template <typename Item>
+static bool writeTempFile(const string& path, const vector<Item>& items) {
+    ofstream file(path + ".tmp");
+    if (!file.is_open()) {
+        cerr << "Error: Could not open " << path << " for writing!" << endl;
+        return false;
+    }
+
+    for (const auto& item : items) {
+        file << item.toFileFormat() << '\n';
+    }
+
+    file.close();
+    return !file.fail();
+}
+
+// Write both text files and the waitlists, then the binary snapshot (if enabled)
+// The binary snapshot is written last so it is never older than the text it mirrors
+// waitlist.txt uses the registrations format; it is only created once someone waits
+bool EventStore::writeDataFiles(const vector<Event>& eventList,
+                                const vector<Registration>& registrationList,
+                                const vector<Registration>& waiterList) {
+    // Several rename() calls are not atomic together, so the set is committed first:
+    // once every temp file is on disk, files.commit (the list of targets) is made
+    // durable - that is the commit point - and only then are the temps renamed.
+    // A crash before the marker leaves the old files untouched (the temps are just
+    // overwritten next time); a crash after it is finished by loadFromFiles(), so the
+    // files are always all old or all new. The journal being compacted is only
+    // deleted after this returns true, i.e. after the renames are durable.
+    vector<string> paths = {eventsPath, registrationsPath};
+    bool writeWaitlist = !waiterList.empty() || getFileStamp(waitlistPath).exists;
+    if (writeWaitlist) paths.push_back(waitlistPath);
+
+    if (!writeTempFile(eventsPath, eventList) ||
+        !writeTempFile(registrationsPath, registrationList) ||
+        (writeWaitlist && !writeTempFile(waitlistPath, waiterList))) {
+        return false;
+    }
+    for (const string& path : paths) {
+        if (!syncFile(path + ".tmp")) return false;
+    }
+
+    {
+        ofstream marker(commitPath + ".tmp");
+        for (const string& path : paths) marker << path << '\n';
+        marker.close();
+        if (marker.fail() || !replaceFileDurably(commitPath + ".tmp", commitPath)) return false;
+    }
+    if (!finishCommit()) return false;
+
+    if (binarySnapshotEnabled) {
+        writeSnapshot(binarySnapshotPath, eventList, registrationList);
+    }
+    return true;
+}
+
+// Complete a committed set of files
+// What it does: Renames each "<target>.tmp" listed in files.commit over its target,
+// flushes the directory and removes the marker. Running it again after a crash part
+// way is safe: targets whose temp file is already gone were renamed before.
+// Only the store's own data files are accepted as targets.
+// Returns: false if a rename failed (the marker stays, so the next load retries)
+bool EventStore::finishCommit() {
+    vector<string> paths;
+    forEachLine(commitPath, [&](string_view line) {
+        if (line == eventsPath || line == registrationsPath || line == waitlistPath) {
+            paths.emplace_back(line);
+        }
+    });
+
+    for (const string& path : paths) {
+        string tempPath = path + ".tmp";
+        if (!getFileStamp(tempPath).exists) continue;
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) return false;
+    }
+    if (!syncParentDirectory(eventsPath)) return false;
+    std::remove(commitPath.c_str());
+    return syncParentDirectory(commitPath);
+}
+
+// Apply one journal record to the in-memory data
+// Record formats:  +|username|eventname|registrationdate   (register / promotion)
+//                  -|username|eventname                    (unregister)
+//                  W|username|eventname|joinedat           (join waitlist)
+//                  L|username|eventname                    (leave waitlist)
+// Malformed lines (e.g. a torn write from a crash) are ignored
+void EventStore::applyJournalRecord(string_view record) {
+    string_view fields[5];
+    size_t count = splitFields(record, '|', fields, 5);
+
+    // Deleted event: its registrations and waitlist go with it
+    // (the catalog is not indexed yet during replay, so the event is looked up by name)
+    if (fields[0] == "X" && count == 2) {
+        registrations.removeEvent(eventSymbols().find(fields[1]));
+        events.erase(remove_if(events.begin(), events.end(),
+                               [&](const Event& event) { return event.getEventName() == fields[1]; }),
+                     events.end());
+        return;
+    }
+    if (count < 3) return;
+
+    // Only the index is touched here - seat counts are rebuilt from it after the replay
+    if (fields[0] == "+" && count == 4) {
+        // add() refuses a registration that is already in the snapshot
+        registrations.add(Registration(userSymbols().intern(fields[1]), eventSymbols().intern(fields[2]),
+                                       parseStoredTimestamp(fields[3], journalPath)));
+    } else if (fields[0] == "B" && count == 5) {
+        // Batch: B|event|timestamp|user1,user2,...|count - applied only if complete
+        vector<string_view> names;
+        for (size_t start = 0;;) {
+            size_t end = fields[3].find(',', start);
+            names.push_back(fields[3].substr(start, end == string_view::npos ? string_view::npos : end - start));
+            if (end == string_view::npos) break;
+            start = end + 1;
+        }
+        int expected = 0;
+        if (!parseInt(fields[4], expected) || (size_t)expected != names.size()) return;
+
+        SymbolId eventId = eventSymbols().intern(fields[1]);
+        Timestamp registeredAt = parseStoredTimestamp(fields[2], journalPath);
+        for (string_view name : names) {
+            registrations.add(Registration(userSymbols().intern(name), eventId, registeredAt));
+        }
+    } else if (fields[0] == "-") {
+        // remove() does nothing if the snapshot already lacks it
+        registrations.remove(userSymbols().find(fields[1]), eventSymbols().find(fields[2]));
+    } else if (fields[0] == "W" && count == 4) {
+        registrations.addWaiter(Registration(userSymbols().intern(fields[1]),
+                                             eventSymbols().intern(fields[2]),
+                                             parseStoredTimestamp(fields[3], journalPath)));
+    } else if (fields[0] == "L") {
+        registrations.removeWaiter(userSymbols().find(fields[1]), eventSymbols().find(fields[2]));
+    }
+}
+
+// Remember the current stamps so our own writes do not look like outside changes
+void EventStore::restampFiles() {
+    eventsStamp = getFileStamp(eventsPath);
+    registrationsStamp = getFileStamp(registrationsPath);
+    journalStamp = getFileStamp(journalPath);
+    waitlistStamp = getFileStamp(waitlistPath);
+    journalRestampNeeded = false;
+}
+
+// Write events to a snapshot file
+// What it does: Writes everything to "<path>.tmp", flushes it and renames it over the
+// target (see replaceFileDurably), so neither a reader nor a crash ever sees a
+// half-written file
+bool EventStore::writeEventsFile(const string& path, const vector<Event>& events) {
+    return writeTempFile(path, events) && replaceFileDurably(path + ".tmp", path);
+}
+
+// Write registrations to a snapshot file (same temp + rename approach)
+bool EventStore::writeRegistrationsFile(const string& path, const vector<Registration>& registrations) {
+    return writeTempFile(path, registrations) && replaceFileDurably(path + ".tmp", path);
+}
+
+// ==================== COMPACTION ====================
+
+// Start folding the journal into the snapshot files on a background thread
+// What it does: Moves the live log aside (new records go to a fresh log), copies the
+// in-memory data and lets a worker thread write events.txt and registrations.txt.
+// When the worker is done the old log is deleted - its records are in the snapshot.
+void EventStore::startCompaction() {
+    finishCompaction(true);
+
+    // An earlier background compaction failed - do it in the foreground instead
+    if (getFileStamp(compactingPath).exists) {
+        compactNow();
+        return;
+    }
+
+    if (!journal.rotate(compactingPath)) return;
+    journalRecords = 0;
+    journalStamp = getFileStamp(journalPath);
+    journalRestampNeeded = false;
+
+    compactionDone = false;
+    compactionThread = thread([this, eventsCopy = events, registrationsCopy = registrations.toVector(),
+                               waitersCopy = registrations.waitersToVector()]() {
+        if (writeDataFiles(eventsCopy, registrationsCopy, waitersCopy)) {
+            std::remove(compactingPath.c_str());
+        }
+        compactionDone = true;
+    });
+}
+
+// Collect a finished background compaction
+// Parameters: wait - block until the worker finishes instead of only checking
+// Returns: true if no compaction is running any more
+bool EventStore::finishCompaction(bool wait) {
+    if (!compactionThread.joinable()) return true;
+    if (!wait && !compactionDone) return false;
+
+    compactionThread.join();
+    restampFiles();
+    return true;
+}
+
+// Fold everything into the snapshot files right now (foreground)
+// Used when the events file must be rewritten anyway, so its counts always match
+bool EventStore::compactNow() {
+    finishCompaction(true);
+    journal.sync();
+
+    if (!writeDataFiles(events, registrations.toVector(), registrations.waitersToVector())) {
+        return false;
+    }
+
+    journal.discard();
+    std::remove(compactingPath.c_str());
+    journalRecords = 0;
+    eventsModified = false;
+    registrationsModified = false;
+    restampFiles();
+    return true;
+}
+
+// Start a background compaction once the log has grown past the threshold
+// Called after the shared lock is released; rotating the log needs it exclusively
+void EventStore::maybeCompact() {
+    if (journalRecords < compactionThreshold) return;
+
+    unique_lock<shared_mutex> guard(catalogLock);
+    if (journalRecords >= compactionThreshold) startCompaction();
+}
+
+// ==================== CACHE MANAGEMENT ====================
+
+// Reload the data if any file changed on disk
+// What it does: Compares each file's current stamp (inode, size, mtime) with the one
+// we recorded and re-reads everything if one differs. Unsaved local changes win, and
+// nothing is checked while our own compaction is rewriting the files.
+void EventStore::refresh() {
+    unique_lock<shared_mutex> guard(catalogLock);
+    if (!finishCompaction(false)) return;
+    if (eventsModified || registrationsModified) return;
+
+    // Our own appends changed the log's stamp; take it now rather than per append
+    if (journalRestampNeeded.exchange(false)) {
+        journalStamp = getFileStamp(journalPath);
+    }
+
+    if (!loaded ||
+        getFileStamp(eventsPath) != eventsStamp ||
+        getFileStamp(registrationsPath) != registrationsStamp ||
+        getFileStamp(journalPath) != journalStamp ||
+        getFileStamp(waitlistPath) != waitlistStamp) {
+        loadFromFiles();
+    }
+}
+
+size_t EventStore::takeRebuiltCounts() {
+    unique_lock<shared_mutex> guard(catalogLock);
+    size_t rebuilt = rebuiltCounts;
+    rebuiltCounts = 0;
+    return rebuilt;
+}
+
+shared_lock<shared_mutex> EventStore::readLock() const {
+    return shared_lock<shared_mutex>(catalogLock);
+}
+
+unique_lock<shared_mutex> EventStore::writeLock() {
+    return unique_lock<shared_mutex>(catalogLock);
+}
+
+vector<Event>& EventStore::getEvents() {
+    return events;
+}
+
+RegistrationIndex& EventStore::getRegistrations() {
+    return registrations;
+}
+
+// Find an event by its exact name
+// What it does: Name -> interned ID -> position, so the lookup is O(1)
+Event* EventStore::findEvent(string_view eventName) {
+    auto it = eventPositions.find(eventSymbols().find(eventName));
+    if (it == eventPositions.end()) return nullptr;
+
+    Event& event = events[it->second];
+    return event.getEventName() == eventName ? &event : nullptr;
+}
+
+// Rebuild the lookup and search indexes
+// What it does: One pass over the events after they are loaded; the first event
+// wins if the files hold the same name twice (as the old linear lookup did)
+void EventStore::rebuildEventIndexes() {
+    eventPositions.clear();
+    searchIndex.clear();
+    dateIndex.clear();
+    for (size_t i = 0; i < events.size(); i++) {
+        SymbolId id = eventSymbols().intern(events[i].getEventName());
+        if (eventPositions.emplace(id, i).second) {
+            searchIndex.add(id, events[i].getEventName(), events[i].getVenue());
+            if (events[i].getDayNumber() != INVALID_DAY) {
+                dateIndex.emplace(events[i].getDayNumber(), id);
+            }
+        }
+    }
+}
+
+// Add an event to the catalog
+void EventStore::addEvent(const Event& event) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    SymbolId id = eventSymbols().intern(event.getEventName());
+    events.push_back(event);
+    eventPositions[id] = events.size() - 1;
+    searchIndex.add(id, event.getEventName(), event.getVenue());
+    if (event.getDayNumber() != INVALID_DAY) dateIndex.emplace(event.getDayNumber(), id);
+}
+
+// Add a batch of events
+// What it does: Same as addEvent() for each one, but takes the catalog lock once
+void EventStore::addEvents(const vector<Event>& newEvents) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    events.reserve(events.size() + newEvents.size());
+    for (const auto& event : newEvents) {
+        SymbolId id = eventSymbols().intern(event.getEventName());
+        events.push_back(event);
+        eventPositions[id] = events.size() - 1;
+        searchIndex.add(id, event.getEventName(), event.getVenue());
+        if (event.getDayNumber() != INVALID_DAY) dateIndex.emplace(event.getDayNumber(), id);
+    }
+}
+
+// Take an event out of the catalog and its indexes (the caller holds the catalog lock)
+// What it does: Erases it and shifts the positions of the events after it down by one
+void EventStore::eraseEvent(SymbolId eventId) {
+    auto it = eventPositions.find(eventId);
+    if (it == eventPositions.end()) return;
+
+    size_t position = it->second;
+    dateIndex.erase({events[position].getDayNumber(), eventId});
+    events.erase(events.begin() + position);
+    eventPositions.erase(it);
+    searchIndex.remove(eventId);
+    for (auto& entry : eventPositions) {
+        if (entry.second > position) entry.second--;
+    }
+}
+
+// Delete an event together with its registrations and waitlist
+// What it does: Journals one "X" record, then drops the event's registrations through
+// its posting list (only those slots become tombstones) and removes the event. No
+// data file is rewritten - the next compaction leaves the event and its registrations
+// out of the snapshot files and reclaims the space.
+// Returns: false if there is no such event or the log could not be written
+bool EventStore::deleteEvent(const string& eventName) {
+    {
+        unique_lock<shared_mutex> guard(catalogLock);
+        SymbolId id = eventSymbols().find(eventName);
+        if (eventPositions.find(id) == eventPositions.end()) return false;
+        if (!appendJournal("X|" + eventName)) return false;
+
+        registrations.removeEvent(id);
+        eraseEvent(id);
+    }
+    maybeCompact();
+    return journal.sync();
+}
+
+// Rename an event
+// What it does: Renames the event's interned ID, so every registration pointing at it
+// shows the new name without touching the registration records themselves.
+// The registrations file still stores names, so it is marked for rewriting.
+// The name is rewritten in place, so nobody may be reading it: the exclusive catalog
+// lock keeps out every store reader, and a running background compaction (which
+// formats names without the lock) is waited for first.
+void EventStore::applyRename(Event& event, const string& newName) {
+    finishCompaction(true);
+    SymbolId id = eventSymbols().intern(event.getEventName());
+    eventSymbols().rename(id, newName);
+    event.setEventName(newName);
+    searchIndex.add(id, newName, event.getVenue());
+    if (registrations.countForEvent(id) > 0) {
+        markRegistrationsModified();
+    }
+}
+
+// Change an event's venue
+void EventStore::applyVenue(Event& event, const string& newVenue) {
+    event.setVenue(newVenue);
+    searchIndex.add(eventSymbols().intern(event.getEventName()), event.getEventName(), newVenue);
+}
+
+// Change an event's date
+void EventStore::applyDate(Event& event, const string& newDate) {
+    SymbolId id = eventSymbols().intern(event.getEventName());
+    dateIndex.erase({event.getDayNumber(), id});
+    event.setDate(newDate);
+    if (event.getDayNumber() != INVALID_DAY) dateIndex.emplace(event.getDayNumber(), id);
+}
+
+void EventStore::renameEvent(Event& event, const string& newName) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    applyRename(event, newName);
+}
+
+void EventStore::setEventVenue(Event& event, const string& newVenue) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    applyVenue(event, newVenue);
+}
+
+void EventStore::setEventDate(Event& event, const string& newDate) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    applyDate(event, newDate);
+}
+
+bool EventStore::renameEvent(const string& eventName, const string& newName) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    Event* event = findEvent(eventName);
+    if (event == nullptr) return false;
+    applyRename(*event, newName);
+    return true;
+}
+
+bool EventStore::setEventVenue(const string& eventName, const string& newVenue) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    Event* event = findEvent(eventName);
+    if (event == nullptr) return false;
+    applyVenue(*event, newVenue);
+    return true;
+}
+
+bool EventStore::setEventDate(const string& eventName, const string& newDate) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    Event* event = findEvent(eventName);
+    if (event == nullptr) return false;
+    applyDate(*event, newDate);
+    return true;
+}
+
+// Events in a date range
+// What it does: Binary-searches the date index for the first entry on or after
+// firstDay, then walks forward until lastDay - only the matching events are visited
+vector<Event*> EventStore::eventsBetween(int32_t firstDay, int32_t lastDay) {
+    shared_lock<shared_mutex> guard(catalogLock);
+    vector<Event*> results;
+    auto it = dateIndex.lower_bound({firstDay, 0});
+    for (; it != dateIndex.end() && it->first <= lastDay; ++it) {
+        results.push_back(&events[eventPositions.at(it->second)]);
+    }
+    return results;
+}
+
+// Events from today on
+vector<Event*> EventStore::upcomingEvents(size_t limit) {
+    shared_lock<shared_mutex> guard(catalogLock);
+    vector<Event*> results;
+    auto it = dateIndex.lower_bound({todayDayNumber(), 0});
+    for (; it != dateIndex.end() && results.size() < limit; ++it) {
+        results.push_back(&events[eventPositions.at(it->second)]);
+    }
+    return results;
+}
+
+// Substring search over names or venues
+// What it does: Gets the matching IDs from the trigram index and returns their events
+// sorted by position, so results come out in the same order as the event list
+vector<Event*> EventStore::searchEvents(string_view query, SearchField field) {
+    shared_lock<shared_mutex> guard(catalogLock);
+    vector<size_t> positions;
+    for (SymbolId id : searchIndex.search(query, field)) {
+        auto it = eventPositions.find(id);
+        if (it != eventPositions.end()) positions.push_back(it->second);
+    }
+    sort(positions.begin(), positions.end());
+
+    vector<Event*> results;
+    results.reserve(positions.size());
+    for (size_t position : positions) {
+        results.push_back(&events[position]);
+    }
+    return results;
+}
+
+// ==================== JOURNALED CHANGES ====================
+
+// Register a student for an event
+// What it does: Validates the request against the in-memory data, then journals it.
+// Only the catalog's shared lock is held, so registrations for other events (other
+// index shards) go ahead in parallel
+RegistrationStatus EventStore::registerStudent(const string& username, const string& eventName,
+                                               const string& dateTime) {
+    RegistrationStatus status;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        Event* event = findEvent(eventName);
+        if (event == nullptr) return REGISTRATION_NO_EVENT;
+        if (registrations.contains(username, eventName)) return REGISTRATION_DUPLICATE;
+
+        // Seats freed while others wait belong to the waitlist (first come, first served)
+        if (registrations.waitingForEvent(eventSymbols().find(eventName)) > 0) return REGISTRATION_FULL;
+
+        // Take the seat first (atomic check-and-increment); give it back if the
+        // write fails or another thread registered the same student first
+        if (!event->tryReserveSeat()) return REGISTRATION_FULL;
+        status = recordRegistration(Registration(username, eventName, dateTime));
+        if (status != REGISTRATION_OK) event->releaseSeat();
+    }
+    maybeCompact();
+    return waitForCommit(status);
+}
+
+// Register a list of students for one event
+// What it does: Under the event's shard lock, drops duplicates, reserves seats for the
+// rest in one step (tryReserveSeats), journals the ones that got a seat as a single
+// record and adds them to the index; then one sync() makes the batch durable.
+// Seats freed while others wait belong to the waitlist, as in registerStudent()
+vector<RegistrationStatus> EventStore::registerStudents(const string& eventName,
+                                                        const vector<string>& usernames,
+                                                        const string& dateTime) {
+    vector<RegistrationStatus> statuses(usernames.size(), REGISTRATION_FULL);
+    vector<bool> duplicate;
+    size_t accepted = 0;
+    bool committed;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        Event* event = findEvent(eventName);
+        if (event == nullptr) {
+            statuses.assign(usernames.size(), REGISTRATION_NO_EVENT);
+            return statuses;
+        }
+
+        vector<Registration> batch;
+        batch.reserve(usernames.size());
+        for (const auto& username : usernames) batch.emplace_back(username, eventName, dateTime);
+        bool waiting = registrations.waitingForEvent(eventSymbols().find(eventName)) > 0;
+
+        committed = registrations.addBatch(batch, duplicate, [&](vector<Registration>& fresh) {
+            size_t seats = waiting ? 0 : (size_t)event->tryReserveSeats((int)fresh.size());
+            fresh.resize(seats);
+            if (fresh.empty()) return true;
+
+            string names;
+            for (const auto& reg : fresh) {
+                if (!names.empty()) names += ",";
+                names += reg.getStudentUsername();
+            }
+            if (!appendJournal("B|" + eventName + "|" + fresh[0].getRegistrationDate() + "|" + names +
+                               "|" + to_string(fresh.size()))) {
+                for (size_t i = 0; i < seats; i++) event->releaseSeat();
+                return false;
+            }
+            accepted = fresh.size();
+            return true;
+        });
+    }
+    maybeCompact();
+    if (accepted > 0 && !journal.sync()) committed = false;
+
+    // The first 'accepted' non-duplicates got seats (addBatch keeps the list order)
+    size_t fresh = 0;
+    for (size_t i = 0; i < usernames.size(); i++) {
+        if (duplicate[i]) {
+            statuses[i] = REGISTRATION_DUPLICATE;
+        } else if (!committed) {
+            statuses[i] = REGISTRATION_FAILED;
+        } else if (fresh++ < accepted) {
+            statuses[i] = REGISTRATION_OK;
+        }
+    }
+    return statuses;
+}
+
+// Unregister a student from an event
+RegistrationStatus EventStore::unregisterStudent(const string& username, const string& eventName) {
+    RegistrationStatus status;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        status = recordRemoval(username, eventName);
+    }
+    maybeCompact();
+    return waitForCommit(status);
+}
+
+// Journal a registration and add it to the index (seat counts are the caller's job)
+// The record is appended under the event's shard lock, after the duplicate check,
+// so the log holds the changes of one (student, event) in the order they happened
+RegistrationStatus EventStore::recordRegistration(const Registration& reg) {
+    bool duplicate = true;
+    bool added = registrations.add(reg, [&]() {
+        duplicate = false;
+        return appendJournal("+|" + reg.toFileFormat());
+    });
+    if (added) return REGISTRATION_OK;
+    return duplicate ? REGISTRATION_DUPLICATE : REGISTRATION_FAILED;
+}
+
+// Journal an unregistration, drop it from the index and free the seat
+RegistrationStatus EventStore::recordRemoval(const string& username, const string& eventName) {
+    bool found = false;
+    bool removed = registrations.remove(userSymbols().find(username), eventSymbols().find(eventName),
+                                        [&]() {
+                                            found = true;
+                                            return appendJournal("-|" + username + "|" + eventName);
+                                        });
+    if (!removed) return found ? REGISTRATION_FAILED : REGISTRATION_NOT_FOUND;
+
+    // The freed seat goes straight to the first waiter; only without one is it released
+    Event* event = findEvent(eventName);
+    if (event != nullptr && !promoteWaiter(eventSymbols().find(eventName))) {
+        event->unregisterStudent();
+    }
+    return REGISTRATION_OK;
+}
+
+// Register the first waiter of an event in a seat the caller already holds
+// One "+" record is journaled, exactly like a normal registration, so replaying the
+// log promotes the same student
+bool EventStore::promoteWaiter(SymbolId eventId) {
+    return registrations.promoteWaiter(eventId, currentTimestamp(),
+                                       [this](const Registration& reg) {
+                                           return appendJournal("+|" + reg.toFileFormat());
+                                       });
+}
+
+// Join an event's waitlist
+// What it does: Tries a normal registration first; if the event is full the student
+// is appended to the waitlist (one "W" record). If a seat was freed in the meantime
+// the first waiter is promoted at once, so nobody waits behind an empty seat
+RegistrationStatus EventStore::joinWaitlist(const string& username, const string& eventName,
+                                            const string& dateTime) {
+    RegistrationStatus status = registerStudent(username, eventName, dateTime);
+    if (status != REGISTRATION_FULL) return status;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        Event* event = findEvent(eventName);
+        if (event == nullptr) return REGISTRATION_NO_EVENT;
+
+        Registration waiter(username, eventName, dateTime);
+        bool refused = true;
+        bool added = registrations.addWaiter(waiter, [&]() {
+            refused = false;
+            return appendJournal("W|" + waiter.toFileFormat());
+        });
+        if (!added) {
+            if (!refused) return REGISTRATION_FAILED;
+            return registrations.contains(waiter.getStudentId(), waiter.getEventId())
+                       ? REGISTRATION_DUPLICATE : REGISTRATION_ALREADY_WAITING;
+        }
+        status = REGISTRATION_WAITLISTED;
+
+        if (event->tryReserveSeat() && !promoteWaiter(waiter.getEventId())) {
+            event->releaseSeat();
+        }
+        if (registrations.contains(waiter.getStudentId(), waiter.getEventId())) {
+            status = REGISTRATION_OK;
+        }
+    }
+    maybeCompact();
+    return waitForCommit(status);
+}
+
+// Leave an event's waitlist (one "L" record)
+RegistrationStatus EventStore::leaveWaitlist(const string& username, const string& eventName) {
+    bool found = false;
+    bool removed;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        removed = registrations.removeWaiter(userSymbols().find(username), eventSymbols().find(eventName),
+                                             [&]() {
+                                                 found = true;
+                                                 return appendJournal("L|" + username + "|" + eventName);
+                                             });
+    }
+    maybeCompact();
+    if (removed) return waitForCommit(REGISTRATION_OK);
+    return found ? REGISTRATION_FAILED : REGISTRATION_NOT_FOUND;
+}
+
+// Promote waiters into an event's free seats
+// What it does: Takes one free seat at a time and hands it to the first waiter,
+// until the seats or the waiters run out
+size_t EventStore::promoteWaiters(const string& eventName) {
+    size_t promoted = 0;
+    {
+        shared_lock<shared_mutex> guard(catalogLock);
+        Event* event = findEvent(eventName);
+        SymbolId eventId = eventSymbols().find(eventName);
+        if (event == nullptr || eventId == NO_SYMBOL) return 0;
+
+        while (event->tryReserveSeat()) {
+            if (!promoteWaiter(eventId)) {
+                event->releaseSeat();
+                break;
+            }
+            promoted++;
+        }
+    }
+    maybeCompact();
+    if (promoted > 0 && waitForCommit(REGISTRATION_OK) != REGISTRATION_OK) return 0;
+    return promoted;
+}
+
+// Append one record to the log and count it towards the next compaction
+// The record is written but not yet flushed; see waitForCommit()
+bool EventStore::appendJournal(const string& record) {
+    if (journal.append(record) == 0) return false;
+    journalRestampNeeded = true;
+    journalRecords++;
+    return true;
+}
+
+// Make a successful change durable before reporting it
+// What it does: Waits until every record this thread appended is on disk. Called
+// after all locks are released; concurrent callers share one disk flush (group
+// commit, see journal.h), so many registrations in flight cost one fdatasync()
+RegistrationStatus EventStore::waitForCommit(RegistrationStatus status) {
+    if (status != REGISTRATION_OK && status != REGISTRATION_WAITLISTED) return status;
+    return journal.sync() ? status : REGISTRATION_FAILED;
+}
+
+void EventStore::markEventsModified() {
+    eventsModified = true;
+}
+
+void EventStore::markRegistrationsModified() {
+    registrationsModified = true;
+}
+
+// Write back only what was modified
+// If registrations changed directly, or events changed while the log still holds
+// records, both snapshot files are rewritten together so their counts agree.
+// Returns: true if every modified file was written successfully
+bool EventStore::save() {
+    unique_lock<shared_mutex> guard(catalogLock);
+    if (registrationsModified || (eventsModified && journalRecords > 0)) {
+        return compactNow();
+    }
+    if (eventsModified) {
+        finishCompaction(true);
+        if (!writeEventsFile(eventsPath, events)) return false;
+        eventsModified = false;
+        restampFiles();
+    }
+    return true;
+}
+
+// Flush journaled records to disk
+bool EventStore::sync() {
+    return journal.sync();
+}
+
+uint64_t EventStore::getSyncCount() const {
+    return journal.getSyncCount();
+}
+
+void EventStore::setCompactionThreshold(size_t records) {
+    compactionThreshold = records > 0 ? records : 1;
+}
+
+// Turn the binary snapshot on or off
+// When turned on, one is written right away from the current data
+bool EventStore::setBinarySnapshot(bool enabled) {
+    unique_lock<shared_mutex> guard(catalogLock);
+    binarySnapshotEnabled = enabled;
+    if (!enabled) {
+        return !getFileStamp(binarySnapshotPath).exists || std::remove(binarySnapshotPath.c_str()) == 0;
+    }
+    finishCompaction(true);
+    return writeSnapshot(binarySnapshotPath, events, registrations.toVector());
+}
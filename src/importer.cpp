@@ -0,0 +1,253 @@
+#include "importer.h"
+#include "mappedfile.h"
+#include "verifierpool.h"
+#include "workerpool.h"
+#include "utils.h"
+#include <iostream>
+#include <unordered_map>
+#include <future>
+#include <algorithm>
+
+// ========================================
+// IMPORTER.CPP - Bulk CSV Import Implementation
+// ========================================
+// This file implements the event and student importers described in importer.h.
+// Each import runs in four steps: read the rows, check each row on its own (in
+// parallel), find duplicates (in file order, so the first occurrence wins), then
+// commit every valid row with one write.
+
+// ==================== CSV READING ====================
+
+// One data row of the file
+struct CsvRow {
+    size_t line;
+    vector<string> fields;
+    string error;    // Empty if the row is valid so far
+};
+
+// Split one CSV line
+// What it does: Walks the line once; inside quotes commas are literal and ""
+// stands for one quote character. Unquoted fields are trimmed, except field
+// number 'rawField', which is kept exactly as written
+bool parseCsvLine(string_view line, vector<string>& fields, size_t rawField) {
+    fields.clear();
+    string field;
+    bool quoted = false, wasQuoted = false;
+
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                field += c;
+            }
+        } else if (c == '"' && trim(field).empty()) {
+            quoted = wasQuoted = true;
+            field.clear();
+        } else if (c == ',') {
+            fields.push_back(wasQuoted || fields.size() == rawField ? field : trim(field));
+            field.clear();
+            wasQuoted = false;
+        } else {
+            field += c;
+        }
+    }
+    fields.push_back(wasQuoted || fields.size() == rawField ? field : trim(field));
+    return !quoted;
+}
+
+// Read every data row of a CSV file
+// What it does: Streams the file through a memory map; blank lines are skipped and
+// so is a first row whose first field is 'headerName' (the column names)
+static bool readCsv(const string& path, const string& headerName, vector<CsvRow>& rows,
+                    size_t rawField = NO_RAW_FIELD) {
+    size_t lineNumber = 0;
+    return forEachLine(path, [&](string_view line) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (trimView(line).empty()) return;
+
+        CsvRow row;
+        row.line = lineNumber;
+        if (!parseCsvLine(line, row.fields, rawField)) row.error = "unterminated quote";
+        if (rows.empty() && row.error.empty() && toLower(trim(row.fields[0])) == headerName) return;
+        rows.push_back(move(row));
+    });
+}
+
+// Run check(row) on every row that has no error yet, spread over a worker pool
+// Each task owns a contiguous chunk of rows, so no two threads touch the same row
+static void checkInParallel(vector<CsvRow>& rows, const function<void(CsvRow&)>& check) {
+    WorkerPool pool;
+    size_t chunk = max<size_t>(256, rows.size() / (pool.threadCount() * 4) + 1);
+    for (size_t begin = 0; begin < rows.size(); begin += chunk) {
+        size_t end = min(rows.size(), begin + chunk);
+        pool.submit([&rows, &check, begin, end] {
+            for (size_t i = begin; i < end; i++) {
+                if (rows[i].error.empty()) check(rows[i]);
+            }
+        });
+    }
+    pool.wait();
+}
+
+// Mark later copies of a key as duplicates
+// 'seen' starts with the keys that already exist (line 0)
+static void markDuplicates(vector<CsvRow>& rows, unordered_map<string, size_t>& seen,
+                           const function<string(const CsvRow&)>& keyOf, const string& what) {
+    for (auto& row : rows) {
+        if (!row.error.empty()) continue;
+
+        auto [it, inserted] = seen.emplace(keyOf(row), row.line);
+        if (inserted) continue;
+        if (it->second == 0) {
+            row.error = what + " '" + row.fields[0] + "' already exists";
+        } else {
+            row.error = "duplicate " + what + " '" + row.fields[0] + "' (first on line " +
+                        to_string(it->second) + ")";
+        }
+    }
+}
+
+// Collect the errors in line order
+static void collectErrors(const vector<CsvRow>& rows, ImportReport& report) {
+    for (const auto& row : rows) {
+        if (!row.error.empty()) report.errors.push_back({row.line, row.error});
+    }
+}
+
+// ==================== REPORT ====================
+
+ImportReport::ImportReport() : fileRead(false), rows(0), imported(0), committed(false) {}
+
+void ImportReport::print() const {
+    if (!fileRead) {
+        cout << "Error: Could not open the import file!" << endl;
+        return;
+    }
+    for (const auto& error : errors) {
+        cout << "Line " << error.line << ": " << error.message << endl;
+    }
+    if (imported > 0 && !committed) {
+        cout << "Error: Failed to save the imported rows!" << endl;
+    }
+    cout << "Imported " << (committed ? imported : 0) << " of " << rows << " row(s), "
+         << errors.size() << " error(s)." << endl;
+}
+
+// ==================== EVENTS ====================
+
+// Import events
+// What it does: Checks every row (4 fields, name and venue present and without '|',
+// a valid date, capacity > 0), rejects names that exist (case-insensitive, like the
+// add-event screen), then adds all valid events and saves events.txt once
+ImportReport importEvents(const string& csvPath, EventStore& store) {
+    ImportReport report;
+    vector<CsvRow> rows;
+    report.fileRead = readCsv(csvPath, "name", rows);
+    if (!report.fileRead) return report;
+    report.rows = rows.size();
+
+    checkInParallel(rows, [](CsvRow& row) {
+        const vector<string>& f = row.fields;
+        int capacity = 0;
+        if (f.size() != 4) {
+            row.error = "expected 4 fields (name,date,venue,capacity), found " + to_string(f.size());
+        } else if (f[0].empty() || f[0].find('|') != string::npos) {
+            row.error = "event name is empty or contains '|'";
+        } else if (!isValidDate(f[1])) {
+            row.error = "invalid date '" + f[1] + "' (DD-MM-YYYY, 2025 or later)";
+        } else if (f[2].empty() || f[2].find('|') != string::npos) {
+            row.error = "venue is empty or contains '|'";
+        } else if (!parseInt(f[3], capacity) || capacity <= 0) {
+            row.error = "capacity must be a whole number greater than 0";
+        }
+    });
+
+    store.refresh();
+    unordered_map<string, size_t> seen;
+    for (const auto& event : store.getEvents()) {
+        seen.emplace(toLower(event.getEventName()), 0);
+    }
+    markDuplicates(rows, seen, [](const CsvRow& row) { return toLower(row.fields[0]); }, "event");
+
+    vector<Event> events;
+    for (const auto& row : rows) {
+        if (!row.error.empty()) continue;
+        int capacity = 0;
+        parseInt(row.fields[3], capacity);
+        events.push_back(Event(row.fields[0], row.fields[1], row.fields[2], capacity, 0));
+    }
+    collectErrors(rows, report);
+
+    report.imported = events.size();
+    if (events.empty()) {
+        report.committed = true;
+        return report;
+    }
+    store.addEvents(events);
+    store.markEventsModified();
+    report.committed = store.save();
+    return report;
+}
+
+// ==================== STUDENTS ====================
+
+// Import student accounts
+// What it does: Checks every row (3 fields, a username without spaces or commas, a
+// password, a full name without commas), rejects usernames that exist, hashes the
+// passwords in parallel on the verifier pool, then appends all accounts at once.
+// The password is taken exactly as written (not trimmed) and may contain commas
+// when quoted; only its hash reaches users.txt
+ImportReport importStudents(const string& csvPath, UserDirectory& directory) {
+    ImportReport report;
+    vector<CsvRow> rows;
+    report.fileRead = readCsv(csvPath, "username", rows, 1);
+    if (!report.fileRead) return report;
+    report.rows = rows.size();
+
+    checkInParallel(rows, [](CsvRow& row) {
+        const vector<string>& f = row.fields;
+        if (f.size() != 3) {
+            row.error = "expected 3 fields (username,password,full name), found " + to_string(f.size());
+        } else if (f[0].empty() || any_of(f[0].begin(), f[0].end(),
+                                          [](char c) { return isspace((unsigned char)c) || c == ','; })) {
+            row.error = "username is empty or contains spaces or commas";
+        } else if (f[1].empty()) {
+            row.error = "password is empty";
+        } else if (f[2].empty() || f[2].find(',') != string::npos) {
+            row.error = "full name is empty or contains a comma";
+        }
+    });
+
+    directory.refresh();
+    unordered_map<string, size_t> seen;
+    for (const auto& user : directory.getUsers()) {
+        seen.emplace(user.username, 0);
+    }
+    markDuplicates(rows, seen, [](const CsvRow& row) { return row.fields[0]; }, "username");
+    collectErrors(rows, report);
+
+    // Hash on the verifier pool: all hashes are queued first, then collected
+    vector<const CsvRow*> valid;
+    vector<future<string>> hashes;
+    for (const auto& row : rows) {
+        if (!row.error.empty()) continue;
+        valid.push_back(&row);
+        hashes.push_back(VerifierPool::instance().hash(row.fields[1]));
+    }
+
+    vector<UserRecord> users;
+    users.reserve(valid.size());
+    for (size_t i = 0; i < valid.size(); i++) {
+        users.push_back(UserRecord{valid[i]->fields[0], hashes[i].get(), valid[i]->fields[2], "student"});
+    }
+
+    report.imported = users.size();
+    report.committed = users.empty() || directory.addUsers(users);
+    return report;
+}
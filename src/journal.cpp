@@ -0,0 +1,163 @@
+#include "journal.h"
+#include "mappedfile.h"
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+// ========================================
+// JOURNAL.CPP - Write-Ahead Log Implementation
+// ========================================
+// This file implements the Journal class: an append-only log file where every
+// registration change is written as one line. The log is replayed at startup and
+// periodically folded ("compacted") into the snapshot files by EventStore.
+// Commits are made durable with group commit (see journal.h).
+
+// Constructor
+// What it does: Remembers the path; the file is opened on first append
+Journal::Journal(const string& logPath)
+    : path(logPath), fd(-1), appendedRecords(0), durableRecords(0), syncCount(0), flushing(false) {}
+
+// Destructor - make sure nothing appended is left unflushed
+Journal::~Journal() {
+    close();
+}
+
+string Journal::getPath() const {
+    return path;
+}
+
+// Append one record
+// What it does: Writes "record\n" with a single write() call at the end of the file.
+// O_APPEND makes the write land at the end even if another process appended too.
+// The record is not flushed here - call waitDurable() with the returned number.
+uint64_t Journal::append(const string& record) {
+    string line = record + "\n";
+    lock_guard<mutex> guard(lock);
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            cerr << "Error: Could not open " << path << " for writing!" << endl;
+            return 0;
+        }
+    }
+
+    size_t written = 0;
+    while (written < line.size()) {
+        ssize_t n = ::write(fd, line.data() + written, line.size() - written);
+        if (n < 0) {
+            cerr << "Error: Could not write to " << path << "!" << endl;
+            return 0;
+        }
+        written += n;
+    }
+    return ++appendedRecords;
+}
+
+// Wait until a record is on disk
+// What it does: If no flush is running, this thread becomes the leader: it notes how
+// many records are written, flushes without holding the lock (so other threads keep
+// appending), then marks all of them durable and wakes the waiters. If a flush is
+// already running, it waits for it; records written after that flush started are
+// covered by the next leader.
+bool Journal::waitDurable(uint64_t sequence) {
+    unique_lock<mutex> guard(lock);
+    while (durableRecords < sequence) {
+        if (flushing) {
+            flushed.wait(guard);
+            continue;
+        }
+        if (fd < 0) return durableRecords >= sequence;
+
+        flushing = true;
+        uint64_t target = appendedRecords;
+        int flushFd = fd;
+        guard.unlock();
+        bool ok = ::fdatasync(flushFd) == 0;
+        guard.lock();
+
+        flushing = false;
+        syncCount++;
+        if (ok && target > durableRecords) durableRecords = target;
+        flushed.notify_all();
+        if (!ok) {
+            cerr << "Error: Could not flush " << path << " to disk!" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Force all appended records to disk
+bool Journal::sync() {
+    uint64_t sequence;
+    {
+        lock_guard<mutex> guard(lock);
+        sequence = appendedRecords;
+    }
+    return waitDurable(sequence);
+}
+
+// Flush everything written so far while holding the lock
+// (waits for a running leader first, so the file is never flushed and closed at once)
+bool Journal::syncLocked(unique_lock<mutex>& guard) {
+    while (flushing) flushed.wait(guard);
+    if (fd < 0 || durableRecords == appendedRecords) return true;
+
+    bool ok = ::fdatasync(fd) == 0;
+    syncCount++;
+    if (ok) durableRecords = appendedRecords;
+    flushed.notify_all();
+    return ok;
+}
+
+uint64_t Journal::getSyncCount() const {
+    lock_guard<mutex> guard(lock);
+    return syncCount;
+}
+
+// Flush and close the file
+void Journal::close() {
+    unique_lock<mutex> guard(lock);
+    closeLocked(guard);
+}
+
+void Journal::closeLocked(unique_lock<mutex>& guard) {
+    if (fd >= 0) {
+        syncLocked(guard);
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+// Move the current log aside and start an empty one
+bool Journal::rotate(const string& newPath) {
+    unique_lock<mutex> guard(lock);
+    closeLocked(guard);
+    if (std::rename(path.c_str(), newPath.c_str()) != 0) {
+        // Nothing to rotate if the log was never written
+        ifstream check(path);
+        return !check.is_open();
+    }
+    return true;
+}
+
+// Remove the log file
+bool Journal::discard() {
+    unique_lock<mutex> guard(lock);
+    closeLocked(guard);
+    return std::remove(path.c_str()) == 0;
+}
+
+// Read every record of a log file
+// What it does: Calls apply() once per non-empty line, in the order they were written
+// The log is scanned through a memory map (see mappedfile.h), records are not copied
+size_t Journal::replay(const string& logPath, const function<void(string_view)>& apply) {
+    size_t count = 0;
+    forEachLine(logPath, [&](string_view record) {
+        apply(record);
+        count++;
+    });
+    return count;
+}
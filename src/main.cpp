@@ -9,6 +9,13 @@
 #include "admin.h"      // Admin class (inherits from User)
 #include "student.h"    // Student class (inherits from User)
 #include "utils.h"      // Utility functions (split, trim, etc.)
+#include "userdirectory.h"  // In-memory users.txt with username index
+#include "password.h"   // Password hashing (PBKDF2)
+#include "verifierpool.h"  // Worker threads for password checks
+#include "server.h"     // Multi-client server mode
+#include "cli.h"        // Non-interactive subcommands
+#include <csignal>      // For stopping the server on Ctrl+C
+#include <cstdlib>      // For getenv
 #include <iostream>     // For input/output (cin, cout)
 #include <fstream>      // For file operations (ifstream, ofstream)
 #include <vector>       // For dynamic arrays (vector)
@@ -17,18 +24,17 @@ using namespace std;    // Avoids writing std:: before cout, cin, string, etc.
 
 // ==================== AUTHENTICATION ====================
 
-// Function to load users from file and authenticate
-// What it does: Reads users.txt, checks if username/password match, creates appropriate User object
+// Function to authenticate a user against the user directory
+// What it does: Looks the username up in the in-memory copy of users.txt (re-read only
+// when the file changes), checks the password, creates appropriate User object
 // Returns: Pointer to Admin or Student object if login successful, nullptr if failed
 // Return type is User* (base class pointer) which can point to Admin or Student objects (polymorphism)
 User* authenticateUser(string username, string password) {
-    // Open the users.txt file for reading
-    // ifstream = "input file stream" (for reading from files)
-    ifstream file("data/users.txt");
-    string line, uname, pass, name, type;    // Variables to store file data
+    // The directory loads users.txt once into a hash map keyed by username
+    UserDirectory& directory = UserDirectory::instance();
     
-    // Check if file opened successfully
-    if (!file.is_open()) {
+    // Check if file could be read
+    if (!directory.refresh()) {
         cout << "Error: Could not open users.txt file!" << endl;
         cout << "Please ensure users.txt exists with proper user data." << endl;
         return nullptr;    // nullptr = null pointer (no valid user)
@@ -36,46 +42,36 @@ User* authenticateUser(string username, string password) {
     
     cout << "Checking credentials..." << endl;
     
-    // File format: username,password,fullname,usertype
-    // Example line: "john,pass123,John Doe,student"
+    // O(1) lookup instead of scanning every line of the file
+    const UserRecord* user = directory.find(username);
     
-    // Read file line by line
-    while (getline(file, line)) {
-        if (line.empty()) continue;    // Skip empty lines
-        
-        // Split the line by comma to get individual fields
-        vector<string> parts = split(line, ',');    // split() is from utils.cpp
+    // Check if credentials match what the user entered
+    // The (deliberately slow) hash check runs on the verifier pool; an unknown user
+    // is checked against a dummy hash so both cases take about the same time
+    static const string dummyHash = hashPassword("", string(PASSWORD_SALT_BYTES, '\0'), getPasswordCost());
+    bool matches = VerifierPool::instance().verify(user != nullptr ? user->password : dummyHash, password).get();
+    
+    if (user != nullptr && matches) {
+        // Plaintext (or old-cost) entries are upgraded to a fresh hash on login
+        if (passwordNeedsRehash(user->password)) {
+            directory.setPassword(user->username, VerifierPool::instance().hash(password).get());
+        }
         
-        // Ensure we have all required fields (at least 4 parts)
-        if (parts.size() >= 4) {
-            // Extract and clean each field (remove whitespace)
-            uname = trim(parts[0]);    // Username
-            pass = trim(parts[1]);     // Password
-            name = trim(parts[2]);     // Full name
-            type = trim(parts[3]);     // User type (admin/student)
-            
-            // Check if credentials match what the user entered
-            if (uname == username && pass == password) {
-                file.close();    // Close the file before returning
-                
-                // POLYMORPHISM IN ACTION!
-                // We return a User* pointer, but it actually points to Admin or Student object
-                // This allows different behaviors based on user type
-                if (type == "admin") {
-                    cout << "Admin access granted!" << endl;
-                    // 'new' creates an Admin object on the heap (dynamic memory allocation)
-                    return new Admin(uname, pass, name);
-                } else if (type == "student") {
-                    cout << "Student access granted!" << endl;
-                    // 'new' creates a Student object on the heap
-                    return new Student(uname, pass, name);
-                }
-            }
+        // POLYMORPHISM IN ACTION!
+        // We return a User* pointer, but it actually points to Admin or Student object
+        // This allows different behaviors based on user type
+        if (user->userType == "admin") {
+            cout << "Admin access granted!" << endl;
+            // 'new' creates an Admin object on the heap (dynamic memory allocation)
+            return new Admin(user->username, user->password, user->fullName);
+        } else if (user->userType == "student") {
+            cout << "Student access granted!" << endl;
+            // 'new' creates a Student object on the heap
+            return new Student(user->username, user->password, user->fullName);
         }
     }
     
     // If we reach here, no matching credentials were found
-    file.close();
     return nullptr;    // Return null pointer to indicate authentication failed
 }
 
@@ -98,15 +94,81 @@ void displayWelcome() {
     cout << "=================================================" << endl;
 }
 
+// ==================== PASSWORD COST ====================
+
+// Apply the EVENT_PASSWORD_COST environment variable, if set
+// What it does: Sets the PBKDF2 iteration count used for new hashes (and for re-hashing
+// on login) in every mode - menus, server and command line
+// Returns: false (after an error on stderr) if the value is not a number >= PASSWORD_MIN_COST
+bool applyPasswordCost() {
+    const char* text = getenv("EVENT_PASSWORD_COST");
+    if (text == nullptr || *text == '\0') return true;
+    
+    int cost = 0;
+    if (!parseInt(text, cost) || cost < PASSWORD_MIN_COST) {
+        cerr << "Error: EVENT_PASSWORD_COST must be a whole number of at least "
+             << PASSWORD_MIN_COST << " (got '" << text << "')" << endl;
+        return false;
+    }
+    setPasswordCost(cost);
+    return true;
+}
+
+// ==================== SERVER MODE ====================
+
+// The running server, so the signal handler can ask it to stop
+static Server* activeServer = nullptr;
+
+static void stopServer(int) {
+    if (activeServer != nullptr) activeServer->stop();    // Only sets a flag
+}
+
+// Run in server mode until Ctrl+C / SIGTERM
+// What it does: Serves the Student and Admin operations to many clients over a
+// Unix socket (see server.h) instead of running the interactive menus
+int runServer(const string& socketPath) {
+    Server server(socketPath);
+    activeServer = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    
+    bool ok = server.run();
+    activeServer = nullptr;
+    return ok ? 0 : 1;
+}
+
 // ==================== MAIN APPLICATION ====================
 
 // Main function - Program execution starts here
 // What it does: Handles login, shows menus, processes user choices, and cleans up
 // Return value: 0 means success, 1 means error/failure
-int main() {
+int main(int argc, char* argv[]) {
+    if (!applyPasswordCost()) return 1;
+    
+    // Server mode: ./event-management --server [socket path]
+    if (argc >= 2 && string(argv[1]) == "--server") {
+        return runServer(argc >= 3 ? argv[2] : "data/server.sock");
+    }
+    
+    // Command line mode: ./event-management list-events --json, register --user ... (see cli.h)
+    if (argc >= 2 && isCliCommand(argv[1])) {
+        return runCliCommand(argc, argv);
+    }
+    
     // Show welcome message first
     displayWelcome();
     
+    // Load the event data up front; seat counts that disagreed with the registrations
+    // were fixed while loading - say so and save the fix so it is not found again
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    size_t rebuilt = store.takeRebuiltCounts();
+    if (rebuilt > 0) {
+        cout << "Note: Registration counts of " << rebuilt
+             << " event(s) did not match their registrations and were rebuilt." << endl;
+        store.save();
+    }
+    
     // Declare variables for login
     string username, password;
     User* currentUser = nullptr;    // Pointer to store logged-in user (base class pointer)
@@ -236,7 +298,7 @@ int main() {
                     break;
                 case 3: {
                     // Search/Filter events submenu
-                    cout << "1. Search by Name" << endl;
+                    cout << "1. Search by Name or Venue" << endl;
                     cout << "2. Filter by Date" << endl;
                     cout << "Choose option: ";
                     int searchChoice;
@@ -244,7 +306,7 @@ int main() {
                     cin.ignore();    // Clear the newline from input buffer
                     
                     if (searchChoice == 1) {
-                        student->searchEventByName();       // Search by partial name match
+                        student->searchEventByName();       // Search by partial name or venue match
                     } else if (searchChoice == 2) {
                         student->filterEventsByDate();      // Filter by specific date
                     } else {
@@ -0,0 +1,130 @@
+#include "mappedfile.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ========================================
+// MAPPEDFILE.CPP - Memory-Mapped File Implementation
+// ========================================
+// This file implements MappedFile and forEachLine(), the loaders' way of reading
+// data files: no ifstream, no getline copies, just views into mapped memory.
+
+// Size of each window forEachLine() maps (grown if a single line is longer)
+static const size_t SCAN_WINDOW = 64 * 1024 * 1024;
+
+// ==================== MAPPED FILE ====================
+
+MappedFile::MappedFile() : data(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Map the whole file read-only
+bool MappedFile::open(const string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = info.st_size;
+    if (length > 0) {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        data = static_cast<const char*>(mapped);
+    }
+    ::close(fd);    // The mapping stays valid after the descriptor is closed
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), length);
+    }
+    data = nullptr;
+    length = 0;
+}
+
+string_view MappedFile::view() const {
+    return string_view(data, length);
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+// ==================== STREAMING LINE SCANNER ====================
+
+// Scan a file line by line through a sliding memory-mapped window
+// What it does: Maps up to SCAN_WINDOW bytes, finds each '\n' with memchr and hands
+// the line before it to onLine(). A line cut off by the end of the window is picked
+// up again at the start of the next window (windows start on a page boundary).
+bool forEachLine(const string& path, const function<void(string_view)>& onLine) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t fileSize = info.st_size;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t window = SCAN_WINDOW;
+    size_t offset = 0;    // First byte not yet handed out
+
+    while (offset < fileSize) {
+        size_t mapStart = offset - (offset % pageSize);
+        size_t mapLength = min(window, fileSize - mapStart);
+        void* mapped = mmap(nullptr, mapLength, PROT_READ, MAP_PRIVATE, fd, mapStart);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(mapped, mapLength, MADV_SEQUENTIAL);
+
+        const char* base = static_cast<const char*>(mapped);
+        const char* end = base + mapLength;
+        const char* lineStart = base + (offset - mapStart);
+        const char* cursor = lineStart;
+        bool lastWindow = (mapStart + mapLength == fileSize);
+
+        while (cursor < end) {
+            const char* newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+            if (newline == nullptr) break;
+            if (newline > cursor) onLine(string_view(cursor, newline - cursor));
+            cursor = newline + 1;
+        }
+
+        // The file does not end with a newline - the rest is the last line
+        if (lastWindow && cursor < end) {
+            onLine(string_view(cursor, end - cursor));
+            cursor = end;
+        }
+
+        munmap(mapped, mapLength);
+
+        if (cursor == lineStart && !lastWindow) {
+            window *= 2;    // One line is longer than the window - map more next time
+        } else {
+            offset = mapStart + (cursor - base);
+        }
+    }
+
+    ::close(fd);
+    return true;
+}
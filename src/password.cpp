@@ -0,0 +1,306 @@
+#include "password.h"
+#include <atomic>
+#include <random>
+#include <cstring>
+
+// ========================================
+// PASSWORD.CPP - Password Hashing Implementation
+// ========================================
+// This file implements SHA-256, HMAC-SHA256 and PBKDF2 (FIPS 180-4, RFC 2104,
+// RFC 8018) without any external library, plus the users.txt hash format on top.
+// PBKDF2 precomputes the HMAC inner/outer key blocks once, so every iteration
+// costs exactly two SHA-256 compressions.
+
+static const string HASH_PREFIX = "$pbkdf2-sha256$";
+
+static atomic<int> passwordCost(PASSWORD_DEFAULT_COST);
+
+// ==================== SHA-256 ====================
+
+static const uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static inline uint32_t rotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+// Running SHA-256 state: feed bytes with update(), read the digest with finish()
+struct Sha256 {
+    uint32_t state[8];
+    unsigned char block[64];
+    size_t blockUsed;
+    uint64_t totalBytes;
+
+    Sha256() : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+               blockUsed(0), totalBytes(0) {}
+
+    // Process one full 64-byte block
+    void compress(const unsigned char* data) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)data[4 * i] << 24) | ((uint32_t)data[4 * i + 1] << 16) |
+                   ((uint32_t)data[4 * i + 2] << 8) | (uint32_t)data[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t choice = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + majority;
+            h = g; g = f; f = e; e = d + temp1;
+            d = c; c = b; b = a; a = temp1 + temp2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+    void update(const unsigned char* data, size_t length) {
+        totalBytes += length;
+        while (length > 0) {
+            size_t take = 64 - blockUsed;
+            if (take > length) take = length;
+            memcpy(block + blockUsed, data, take);
+            blockUsed += take;
+            data += take;
+            length -= take;
+            if (blockUsed == 64) {
+                compress(block);
+                blockUsed = 0;
+            }
+        }
+    }
+
+    void update(const string& data) {
+        update(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    }
+
+    // Pad, append the bit length and write the 32-byte digest
+    void finish(unsigned char digest[32]) {
+        uint64_t bitLength = totalBytes * 8;
+        block[blockUsed++] = 0x80;
+        if (blockUsed > 56) {
+            memset(block + blockUsed, 0, 64 - blockUsed);
+            compress(block);
+            blockUsed = 0;
+        }
+        memset(block + blockUsed, 0, 56 - blockUsed);
+        for (int i = 0; i < 8; i++) {
+            block[56 + i] = (unsigned char)(bitLength >> (56 - 8 * i));
+        }
+        compress(block);
+
+        for (int i = 0; i < 8; i++) {
+            digest[4 * i] = (unsigned char)(state[i] >> 24);
+            digest[4 * i + 1] = (unsigned char)(state[i] >> 16);
+            digest[4 * i + 2] = (unsigned char)(state[i] >> 8);
+            digest[4 * i + 3] = (unsigned char)state[i];
+        }
+    }
+};
+
+string sha256(const string& data) {
+    Sha256 context;
+    context.update(data);
+    unsigned char digest[32];
+    context.finish(digest);
+    return string(reinterpret_cast<const char*>(digest), 32);
+}
+
+// ==================== HMAC / PBKDF2 ====================
+
+// HMAC key schedule: SHA-256 states that have already absorbed key^ipad / key^opad
+struct HmacKey {
+    Sha256 inner;
+    Sha256 outer;
+
+    explicit HmacKey(const string& key) {
+        unsigned char keyBlock[64] = {0};
+        if (key.size() > 64) {
+            string hashed = sha256(key);
+            memcpy(keyBlock, hashed.data(), hashed.size());
+        } else {
+            memcpy(keyBlock, key.data(), key.size());
+        }
+
+        unsigned char pad[64];
+        for (int i = 0; i < 64; i++) pad[i] = keyBlock[i] ^ 0x36;
+        inner.update(pad, 64);
+        for (int i = 0; i < 64; i++) pad[i] = keyBlock[i] ^ 0x5c;
+        outer.update(pad, 64);
+    }
+
+    // HMAC of one message, starting from copies of the precomputed states
+    void mac(const unsigned char* message, size_t length, unsigned char out[32]) const {
+        Sha256 innerHash = inner;
+        innerHash.update(message, length);
+        unsigned char innerDigest[32];
+        innerHash.finish(innerDigest);
+
+        Sha256 outerHash = outer;
+        outerHash.update(innerDigest, 32);
+        outerHash.finish(out);
+    }
+};
+
+string hmacSha256(const string& key, const string& message) {
+    unsigned char out[32];
+    HmacKey(key).mac(reinterpret_cast<const unsigned char*>(message.data()), message.size(), out);
+    return string(reinterpret_cast<const char*>(out), 32);
+}
+
+// PBKDF2-HMAC-SHA256
+// What it does: For each 32-byte output block i: U1 = HMAC(salt || i), Uj = HMAC(Uj-1),
+// and the block is U1 ^ U2 ^ ... ^ U<iterations>
+string pbkdf2Sha256(const string& password, const string& salt, int iterations, size_t length) {
+    HmacKey key(password);
+    string result;
+    result.reserve(length);
+
+    for (uint32_t blockIndex = 1; result.size() < length; blockIndex++) {
+        string first = salt;
+        first += (char)(blockIndex >> 24);
+        first += (char)(blockIndex >> 16);
+        first += (char)(blockIndex >> 8);
+        first += (char)blockIndex;
+
+        unsigned char u[32], t[32];
+        key.mac(reinterpret_cast<const unsigned char*>(first.data()), first.size(), u);
+        memcpy(t, u, 32);
+        for (int i = 1; i < iterations; i++) {
+            key.mac(u, 32, u);
+            for (int j = 0; j < 32; j++) t[j] ^= u[j];
+        }
+
+        size_t take = length - result.size();
+        if (take > 32) take = 32;
+        result.append(reinterpret_cast<const char*>(t), take);
+    }
+    return result;
+}
+
+// ==================== HEX ====================
+
+string toHex(const string& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    string hex;
+    hex.reserve(bytes.size() * 2);
+    for (unsigned char byte : bytes) {
+        hex += digits[byte >> 4];
+        hex += digits[byte & 0x0f];
+    }
+    return hex;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool fromHex(const string& hex, string& bytes) {
+    if (hex.size() % 2 != 0) return false;
+    bytes.clear();
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        int high = hexValue(hex[i]);
+        int low = hexValue(hex[i + 1]);
+        if (high < 0 || low < 0) return false;
+        bytes += (char)((high << 4) | low);
+    }
+    return true;
+}
+
+// ==================== STORED FORMAT ====================
+
+int getPasswordCost() {
+    return passwordCost.load();
+}
+
+void setPasswordCost(int iterations) {
+    passwordCost.store(iterations > 0 ? iterations : 1);
+}
+
+// Compare without stopping at the first difference
+static bool constantTimeEquals(const string& a, const string& b) {
+    if (a.size() != b.size()) return false;
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        difference |= (unsigned char)(a[i] ^ b[i]);
+    }
+    return difference == 0;
+}
+
+// Split "$pbkdf2-sha256$iter$salt$hash" into its parts
+static bool parseHash(const string& stored, int& iterations, string& salt, string& hash) {
+    if (stored.compare(0, HASH_PREFIX.size(), HASH_PREFIX) != 0) return false;
+
+    size_t saltStart = stored.find('$', HASH_PREFIX.size());
+    if (saltStart == string::npos) return false;
+    size_t hashStart = stored.find('$', saltStart + 1);
+    if (hashStart == string::npos) return false;
+
+    string cost = stored.substr(HASH_PREFIX.size(), saltStart - HASH_PREFIX.size());
+    if (cost.empty() || cost.size() > 9 || cost.find_first_not_of("0123456789") != string::npos) {
+        return false;
+    }
+    iterations = stoi(cost);
+    return iterations > 0 &&
+           fromHex(stored.substr(saltStart + 1, hashStart - saltStart - 1), salt) &&
+           fromHex(stored.substr(hashStart + 1), hash) && !hash.empty();
+}
+
+string hashPassword(const string& password, const string& salt, int iterations) {
+    string hash = pbkdf2Sha256(password, salt, iterations, PASSWORD_HASH_BYTES);
+    return HASH_PREFIX + to_string(iterations) + "$" + toHex(salt) + "$" + toHex(hash);
+}
+
+string hashPassword(const string& password) {
+    static thread_local random_device source;
+    string salt;
+    for (size_t i = 0; i < PASSWORD_SALT_BYTES; i++) {
+        salt += (char)(source() & 0xff);
+    }
+    return hashPassword(password, salt, getPasswordCost());
+}
+
+bool isHashedPassword(const string& stored) {
+    return stored.compare(0, HASH_PREFIX.size(), HASH_PREFIX) == 0;
+}
+
+// Verify a password
+// What it does: Re-derives the hash with the stored salt and cost and compares.
+// A legacy plaintext entry is compared directly.
+bool verifyPassword(const string& stored, const string& password) {
+    if (!isHashedPassword(stored)) {
+        return constantTimeEquals(stored, password);
+    }
+
+    int iterations;
+    string salt, hash;
+    if (!parseHash(stored, iterations, salt, hash)) return false;
+    return constantTimeEquals(pbkdf2Sha256(password, salt, iterations, hash.size()), hash);
+}
+
+bool passwordNeedsRehash(const string& stored) {
+    int iterations;
+    string salt, hash;
+    if (!parseHash(stored, iterations, salt, hash)) return true;
+    return iterations != getPasswordCost();
+}
@@ -1,4 +1,5 @@
 #include "registration.h"
+#include "utils.h"
 
 // ========================================
 // REGISTRATION.CPP - Registration Class Implementation
@@ -9,24 +10,41 @@
 // Constructor with member initializer list
 // What it does: Creates a Registration object linking a student to an event
 // Parameters: username (student's username), event (event name), regDate (registration timestamp)
-// The colon syntax (:) is called a "member initializer list" - it's more efficient than assigning in the body
+// The names are interned: only their integer IDs are stored in the object
 Registration::Registration(string username, string event, string regDate)
-    : studentUsername(username),      // Initialize studentUsername member
-      eventName(event),                // Initialize eventName member
-      registrationDate(regDate) {}     // Initialize registrationDate member
+    : studentId(userSymbols().intern(username)),     // Username -> compact ID
+      eventId(eventSymbols().intern(event)),          // Event name -> compact ID
+      registeredAt(parseTimestamp(regDate)) {}        // "DD-MM-YYYY HH:MM" -> minutes since 1970
+
+// Constructor from IDs that are already interned (no string work at all)
+Registration::Registration(SymbolId student, SymbolId event, Timestamp timestamp)
+    : studentId(student), eventId(event), registeredAt(timestamp) {}
 
 // Getter methods - Allow read-only access to private member variables
 // 'const' at the end means these functions don't modify the object
-string Registration::getStudentUsername() const { 
-    return studentUsername;    // Return which student registered
+// Names are looked up in the shared dictionaries
+const string& Registration::getStudentUsername() const { 
+    return userSymbols().name(studentId);      // Return which student registered
 }
 
-string Registration::getEventName() const { 
-    return eventName;          // Return which event they registered for
+const string& Registration::getEventName() const { 
+    return eventSymbols().name(eventId);       // Return which event they registered for
 }
 
 string Registration::getRegistrationDate() const { 
-    return registrationDate;   // Return when they registered
+    return formatTimestamp(registeredAt);      // Return when they registered (formatted)
+}
+
+SymbolId Registration::getStudentId() const {
+    return studentId;
+}
+
+SymbolId Registration::getEventId() const {
+    return eventId;
+}
+
+Timestamp Registration::getRegisteredAt() const {
+    return registeredAt;
 }
 
 // Format registration data for file storage
@@ -35,13 +53,13 @@ string Registration::getRegistrationDate() const {
 // Example: "john|Tech Fest 2025|15-03-2025 14:30"
 // Why pipe (|): We use | as a separator because event names might contain commas
 string Registration::toFileFormat() const {
-    return studentUsername + "|" + eventName + "|" + registrationDate;
+    return getStudentUsername() + "|" + getEventName() + "|" + getRegistrationDate();
 }
 
 // Display registration info to console
 // What it does: Prints the registration details in a readable format
 // Used by: Admin when viewing registration reports
 void Registration::display() const {
-    cout << "  " << studentUsername << " -> " << eventName 
-         << " (Registered: " << registrationDate << ")" << endl;
+    cout << "  " << getStudentUsername() << " -> " << getEventName() 
+         << " (Registered: " << getRegistrationDate() << ")" << endl;
 }
@@ -0,0 +1,499 @@
+#include "registrationindex.h"
+#include <algorithm>
+#include <unordered_set>
+
+// ========================================
+// REGISTRATIONINDEX.CPP - Registration Index Implementation
+// ========================================
+// This file implements RegistrationIndex, which keeps every registration together
+// with hash indexes so lookups never have to scan the whole registration list.
+// All keys are interned IDs, so hashing and comparing are integer operations.
+// The string overloads look the name up in the symbol table first; a name that was
+// never interned cannot have any registrations.
+// Each public method locks only the shard(s) it needs (see registrationindex.h).
+
+// Pack (student ID, event ID) into one 64-bit key
+uint64_t RegistrationIndex::makeKey(SymbolId studentId, SymbolId eventId) {
+    return ((uint64_t)studentId << 32) | eventId;
+}
+
+RegistrationIndex::RegistrationIndex() : nextSequence(0) {}
+
+RegistrationIndex::Shard& RegistrationIndex::shardFor(SymbolId eventId) {
+    return shards[eventId % SHARD_COUNT];
+}
+
+const RegistrationIndex::Shard& RegistrationIndex::shardFor(SymbolId eventId) const {
+    return shards[eventId % SHARD_COUNT];
+}
+
+// ==================== SHARD INTERNALS (caller holds the shard lock) ====================
+
+void RegistrationIndex::Shard::clear() {
+    clearSlots();
+    waitlists.clear();
+    waitTickets.clear();
+    waitsByStudent.clear();
+}
+
+// Drop the registrations only (the waitlists stay)
+void RegistrationIndex::Shard::clearSlots() {
+    slots.clear();
+    sequence.clear();
+    live.clear();
+    studentPosition.clear();
+    eventPosition.clear();
+    liveCount = 0;
+    slotByKey.clear();
+    slotsByStudent.clear();
+    slotsByEvent.clear();
+}
+
+// Store a registration in a new slot and record that slot in all three indexes
+void RegistrationIndex::Shard::insert(const Registration& reg, uint64_t order) {
+    size_t slot = slots.size();
+    slots.push_back(reg);
+    sequence.push_back(order);
+    live.push_back(true);
+    liveCount++;
+
+    uint64_t key = makeKey(reg.getStudentId(), reg.getEventId());
+    slotByKey[key] = slot;
+    vector<size_t>& studentSlots = slotsByStudent[reg.getStudentId()];
+    vector<size_t>& eventSlots = slotsByEvent[reg.getEventId()];
+    studentPosition.push_back(studentSlots.size());
+    eventPosition.push_back(eventSlots.size());
+    studentSlots.push_back(slot);
+    eventSlots.push_back(slot);
+
+    // A registered student is no longer waiting (e.g. a replayed promotion)
+    dropWaiter(key);
+}
+
+// Forget a waiter's ticket; its queue entry becomes stale
+// Returns: false if (student, event) was not waiting
+bool RegistrationIndex::Shard::dropWaiter(uint64_t key) {
+    auto ticket = waitTickets.find(key);
+    if (ticket == waitTickets.end()) return false;
+    waitTickets.erase(ticket);
+
+    SymbolId eventId = (SymbolId)(key & 0xFFFFFFFFu);
+    forgetWait((SymbolId)(key >> 32), eventId);
+    WaitQueue& queue = waitlists[eventId];
+    queue.live--;
+
+    // Mostly stale entries: compact the queue so it does not grow without bound
+    if (queue.live == 0) {
+        waitlists.erase(eventId);
+    } else if (queue.entries.size() > 2 * queue.live + 16) {
+        deque<pair<uint64_t, Registration>> current;
+        for (const auto& entry : queue.entries) {
+            if (isCurrent(entry)) current.push_back(entry);
+        }
+        queue.entries.swap(current);
+    }
+    return true;
+}
+
+// Drop a waiter from the per-student list
+void RegistrationIndex::Shard::forgetWait(SymbolId studentId, SymbolId eventId) {
+    auto it = waitsByStudent.find(studentId);
+    if (it == waitsByStudent.end()) return;
+    it->second.erase(eventId);
+    if (it->second.empty()) waitsByStudent.erase(it);
+}
+
+// Is this queue entry still the student's place in line?
+bool RegistrationIndex::Shard::isCurrent(const pair<uint64_t, Registration>& entry) const {
+    auto ticket = waitTickets.find(makeKey(entry.second.getStudentId(), entry.second.getEventId()));
+    return ticket != waitTickets.end() && ticket->second == entry.first;
+}
+
+// Turn a slot into a tombstone and drop it from the posting lists
+// What it does: Moves the last entry of each list into the slot's place and updates
+// that entry's stored position, so removal is O(1) whatever the list length
+void RegistrationIndex::Shard::removeSlot(size_t slot) {
+    const Registration& reg = slots[slot];
+
+    auto dropFrom = [slot](unordered_map<SymbolId, vector<size_t>>& lists, SymbolId id,
+                           vector<size_t>& positions) {
+        auto it = lists.find(id);
+        if (it == lists.end()) return;
+        vector<size_t>& list = it->second;
+        size_t moved = list.back();
+        list[positions[slot]] = moved;
+        positions[moved] = positions[slot];
+        list.pop_back();
+        if (list.empty()) lists.erase(it);
+    };
+    dropFrom(slotsByStudent, reg.getStudentId(), studentPosition);
+    dropFrom(slotsByEvent, reg.getEventId(), eventPosition);
+
+    live[slot] = false;
+    liveCount--;
+}
+
+// Rebuild the slots without tombstones once they make up more than half of them
+void RegistrationIndex::Shard::reclaimTombstones() {
+    if (slots.size() - liveCount <= liveCount) return;
+
+    vector<Registration> survivors;
+    vector<uint64_t> survivorOrder;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (live[i]) {
+            survivors.push_back(slots[i]);
+            survivorOrder.push_back(sequence[i]);
+        }
+    }
+    clearSlots();
+    for (size_t i = 0; i < survivors.size(); i++) {
+        insert(survivors[i], survivorOrder[i]);
+    }
+}
+
+// ==================== PUBLIC OPERATIONS ====================
+
+void RegistrationIndex::clear() {
+    for (auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        shard.clear();
+    }
+}
+
+size_t RegistrationIndex::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.liveCount;
+    }
+    return total;
+}
+
+bool RegistrationIndex::empty() const {
+    return size() == 0;
+}
+
+bool RegistrationIndex::contains(SymbolId studentId, SymbolId eventId) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    return shard.slotByKey.count(makeKey(studentId, eventId)) > 0;
+}
+
+bool RegistrationIndex::contains(const string& username, const string& eventName) const {
+    SymbolId studentId = userSymbols().find(username);
+    SymbolId eventId = eventSymbols().find(eventName);
+    if (studentId == NO_SYMBOL || eventId == NO_SYMBOL) return false;
+    return contains(studentId, eventId);
+}
+
+bool RegistrationIndex::find(SymbolId studentId, SymbolId eventId, Registration& result) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.slotByKey.find(makeKey(studentId, eventId));
+    if (it == shard.slotByKey.end()) return false;
+    result = shard.slots[it->second];
+    return true;
+}
+
+// Add a registration
+// What it does: Under the event's shard lock: refuse duplicates, run 'commit'
+// (e.g. append the journal record), then store the registration
+bool RegistrationIndex::add(const Registration& reg, const function<bool()>& commit) {
+    Shard& shard = shardFor(reg.getEventId());
+    lock_guard<mutex> guard(shard.lock);
+    if (shard.slotByKey.count(makeKey(reg.getStudentId(), reg.getEventId())) > 0) return false;
+    if (commit && !commit()) return false;
+
+    shard.insert(reg, nextSequence++);
+    return true;
+}
+
+// Add a batch for one event
+// What it does: Filters out duplicates (against the shard and within the batch), lets
+// 'commit' trim and journal what is left, then stores the survivors - all under the
+// one shard lock, so no other change to the event can interleave
+bool RegistrationIndex::addBatch(const vector<Registration>& regs, vector<bool>& duplicate,
+                                 const function<bool(vector<Registration>&)>& commit) {
+    duplicate.assign(regs.size(), false);
+    if (regs.empty()) return true;
+
+    Shard& shard = shardFor(regs[0].getEventId());
+    lock_guard<mutex> guard(shard.lock);
+
+    vector<Registration> fresh;
+    unordered_set<uint64_t> seen;
+    for (size_t i = 0; i < regs.size(); i++) {
+        uint64_t key = makeKey(regs[i].getStudentId(), regs[i].getEventId());
+        if (shard.slotByKey.count(key) > 0 || !seen.insert(key).second) {
+            duplicate[i] = true;
+        } else {
+            fresh.push_back(regs[i]);
+        }
+    }
+    if (commit && !commit(fresh)) return false;
+
+    for (const auto& reg : fresh) shard.insert(reg, nextSequence++);
+    return true;
+}
+
+bool RegistrationIndex::remove(SymbolId studentId, SymbolId eventId, const function<bool()>& commit) {
+    Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.slotByKey.find(makeKey(studentId, eventId));
+    if (it == shard.slotByKey.end()) return false;
+    if (commit && !commit()) return false;
+
+    size_t slot = it->second;
+    shard.slotByKey.erase(it);
+    shard.removeSlot(slot);
+    shard.reclaimTombstones();
+    return true;
+}
+
+bool RegistrationIndex::remove(const string& username, const string& eventName) {
+    SymbolId studentId = userSymbols().find(username);
+    SymbolId eventId = eventSymbols().find(eventName);
+    if (studentId == NO_SYMBOL || eventId == NO_SYMBOL) return false;
+    return remove(studentId, eventId);
+}
+
+// Remove all registrations of one event using its posting list
+size_t RegistrationIndex::removeEvent(SymbolId eventId) {
+    Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+
+    // Its waitlist goes too
+    auto queue = shard.waitlists.find(eventId);
+    if (queue != shard.waitlists.end()) {
+        for (const auto& entry : queue->second.entries) {
+            if (!shard.isCurrent(entry)) continue;
+            shard.waitTickets.erase(makeKey(entry.second.getStudentId(), eventId));
+            shard.forgetWait(entry.second.getStudentId(), eventId);
+        }
+        shard.waitlists.erase(queue);
+    }
+
+    auto it = shard.slotsByEvent.find(eventId);
+    if (it == shard.slotsByEvent.end()) return 0;
+
+    vector<size_t> eventSlots = it->second;    // Copy - removeSlot edits the list
+    for (size_t slot : eventSlots) {
+        shard.slotByKey.erase(makeKey(shard.slots[slot].getStudentId(), eventId));
+        shard.removeSlot(slot);
+    }
+    shard.reclaimTombstones();
+    return eventSlots.size();
+}
+
+// Sort (sequence, registration) pairs back into the order they were added
+vector<Registration> RegistrationIndex::inOrder(vector<pair<uint64_t, Registration>>& entries) {
+    sort(entries.begin(), entries.end(),
+         [](const pair<uint64_t, Registration>& a, const pair<uint64_t, Registration>& b) {
+             return a.first < b.first;
+         });
+    vector<Registration> result;
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+// A student's registrations can be in any shard, so each shard's list is collected
+vector<Registration> RegistrationIndex::forStudent(const string& username) const {
+    vector<pair<uint64_t, Registration>> entries;
+    SymbolId studentId = userSymbols().find(username);
+    if (studentId == NO_SYMBOL) return {};
+
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.slotsByStudent.find(studentId);
+        if (it == shard.slotsByStudent.end()) continue;
+        for (size_t slot : it->second) {
+            entries.emplace_back(shard.sequence[slot], shard.slots[slot]);
+        }
+    }
+    return inOrder(entries);
+}
+
+// An event's registrations all live in its own shard (the list is unordered, so
+// it is sorted back into insertion order)
+vector<Registration> RegistrationIndex::forEvent(const string& eventName) const {
+    vector<pair<uint64_t, Registration>> entries;
+    SymbolId eventId = eventSymbols().find(eventName);
+    if (eventId == NO_SYMBOL) return {};
+
+    {
+        const Shard& shard = shardFor(eventId);
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.slotsByEvent.find(eventId);
+        if (it == shard.slotsByEvent.end()) return {};
+
+        entries.reserve(it->second.size());
+        for (size_t slot : it->second) {
+            entries.emplace_back(shard.sequence[slot], shard.slots[slot]);
+        }
+    }
+    return inOrder(entries);
+}
+
+size_t RegistrationIndex::countForEvent(SymbolId eventId) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.slotsByEvent.find(eventId);
+    return it == shard.slotsByEvent.end() ? 0 : it->second.size();
+}
+
+size_t RegistrationIndex::countForEvent(const string& eventName) const {
+    SymbolId eventId = eventSymbols().find(eventName);
+    if (eventId == NO_SYMBOL) return 0;
+    return countForEvent(eventId);
+}
+
+void RegistrationIndex::forEach(const function<void(const Registration&)>& visit) const {
+    for (const auto& reg : toVector()) {
+        visit(reg);
+    }
+}
+
+vector<Registration> RegistrationIndex::toVector() const {
+    vector<pair<uint64_t, Registration>> entries;
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        for (size_t i = 0; i < shard.slots.size(); i++) {
+            if (shard.live[i]) entries.emplace_back(shard.sequence[i], shard.slots[i]);
+        }
+    }
+    return inOrder(entries);
+}
+
+// ==================== WAITLISTS ====================
+
+// Join an event's waitlist
+// What it does: Under the event's shard lock: refuse students who are registered or
+// already waiting, run 'commit', then append the student with a new ticket
+bool RegistrationIndex::addWaiter(const Registration& reg, const function<bool()>& commit) {
+    Shard& shard = shardFor(reg.getEventId());
+    lock_guard<mutex> guard(shard.lock);
+    uint64_t key = makeKey(reg.getStudentId(), reg.getEventId());
+    if (shard.slotByKey.count(key) > 0 || shard.waitTickets.count(key) > 0) return false;
+    if (commit && !commit()) return false;
+
+    uint64_t ticket = nextSequence++;
+    WaitQueue& queue = shard.waitlists[reg.getEventId()];
+    queue.entries.emplace_back(ticket, reg);
+    queue.live++;
+    shard.waitTickets[key] = ticket;
+    shard.waitsByStudent[reg.getStudentId()][reg.getEventId()] = make_pair(ticket, reg);
+    return true;
+}
+
+bool RegistrationIndex::removeWaiter(SymbolId studentId, SymbolId eventId, const function<bool()>& commit) {
+    Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    uint64_t key = makeKey(studentId, eventId);
+    if (shard.waitTickets.count(key) == 0) return false;
+    if (commit && !commit()) return false;
+    return shard.dropWaiter(key);
+}
+
+// Promote the first waiter
+// What it does: Skips stale entries at the front of the queue, registers the first
+// current waiter and removes them from the waitlist - all under one shard lock, so
+// the seat being handed over can not be taken by anyone else in between
+bool RegistrationIndex::promoteWaiter(SymbolId eventId, Timestamp registeredAt,
+                                      const function<bool(const Registration&)>& commit,
+                                      Registration* promoted) {
+    Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.waitlists.find(eventId);
+    if (it == shard.waitlists.end()) return false;
+
+    deque<pair<uint64_t, Registration>>& entries = it->second.entries;
+    while (!entries.empty() && !shard.isCurrent(entries.front())) {
+        entries.pop_front();
+    }
+    if (entries.empty()) return false;
+
+    Registration reg(entries.front().second.getStudentId(), eventId, registeredAt);
+    if (commit && !commit(reg)) return false;
+
+    // insert() also drops the waiter's ticket (and the queue once it is empty)
+    entries.pop_front();
+    shard.insert(reg, nextSequence++);
+    if (promoted != nullptr) *promoted = reg;
+    return true;
+}
+
+bool RegistrationIndex::isWaiting(SymbolId studentId, SymbolId eventId) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    return shard.waitTickets.count(makeKey(studentId, eventId)) > 0;
+}
+
+size_t RegistrationIndex::waitingForEvent(SymbolId eventId) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.waitlists.find(eventId);
+    return it == shard.waitlists.end() ? 0 : it->second.live;
+}
+
+size_t RegistrationIndex::waitlistPosition(SymbolId studentId, SymbolId eventId) const {
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto ticket = shard.waitTickets.find(makeKey(studentId, eventId));
+    if (ticket == shard.waitTickets.end()) return 0;
+
+    size_t position = 0;
+    for (const auto& entry : shard.waitlists.at(eventId).entries) {
+        if (!shard.isCurrent(entry)) continue;
+        position++;
+        if (entry.first == ticket->second) break;
+    }
+    return position;
+}
+
+vector<Registration> RegistrationIndex::waitlistForStudent(const string& username) const {
+    vector<pair<uint64_t, Registration>> entries;
+    SymbolId studentId = userSymbols().find(username);
+    if (studentId == NO_SYMBOL) return {};
+
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.waitsByStudent.find(studentId);
+        if (it == shard.waitsByStudent.end()) continue;
+        for (const auto& wait : it->second) {
+            entries.push_back(wait.second);
+        }
+    }
+    return inOrder(entries);
+}
+
+vector<Registration> RegistrationIndex::waitlistForEvent(const string& eventName) const {
+    vector<Registration> result;
+    SymbolId eventId = eventSymbols().find(eventName);
+    if (eventId == NO_SYMBOL) return result;
+
+    const Shard& shard = shardFor(eventId);
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.waitlists.find(eventId);
+    if (it == shard.waitlists.end()) return result;
+
+    for (const auto& entry : it->second.entries) {
+        if (shard.isCurrent(entry)) result.push_back(entry.second);
+    }
+    return result;
+}
+
+vector<Registration> RegistrationIndex::waitersToVector() const {
+    vector<pair<uint64_t, Registration>> entries;
+    for (const auto& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        for (const auto& queue : shard.waitlists) {
+            for (const auto& entry : queue.second.entries) {
+                if (shard.isCurrent(entry)) entries.push_back(entry);
+            }
+        }
+    }
+    return inOrder(entries);
+}
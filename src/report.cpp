@@ -0,0 +1,62 @@
+#include "report.h"
+#include "utils.h"
+#include <unordered_map>
+#include <algorithm>
+
+// ========================================
+// REPORT.CPP - Report Engine Implementation
+// ========================================
+// This file builds the registration numbers shown on the admin report screens.
+// Counts are read from the per-event posting lists of the registration index
+// instead of comparing every event against every registration (O(E·R)).
+
+double EventSummary::occupancy() const {
+    return capacity > 0 ? (registered * 100.0 / capacity) : 0;
+}
+
+RegistrationSummary::RegistrationSummary() : totalCapacity(0), totalRegistered(0) {}
+
+double RegistrationSummary::occupancy() const {
+    return totalCapacity > 0 ? (totalRegistered * 100.0 / totalCapacity) : 0;
+}
+
+// Build the registration summary
+// What it does: One pass over the events; each event's count is an O(1) lookup
+// of its posting-list size in the registration index
+RegistrationSummary buildRegistrationSummary(const vector<Event>& events,
+                                             const RegistrationIndex& registrations) {
+    RegistrationSummary summary;
+    summary.events.reserve(events.size());
+
+    for (const auto& event : events) {
+        EventSummary row;
+        row.eventName = event.getEventName();
+        row.capacity = event.getCapacity();
+        row.registered = (int)registrations.countForEvent(row.eventName);
+
+        summary.totalCapacity += row.capacity;
+        summary.totalRegistered += row.registered;
+        summary.events.push_back(row);
+    }
+
+    return summary;
+}
+
+// Registrations per hour
+// What it does: Counts registrations per hour bucket (timestamp / 60), then sorts the
+// buckets - O(R + H log H) for R registrations spread over H distinct hours
+vector<HourlyCount> buildHourlyRegistrations(const RegistrationIndex& registrations) {
+    unordered_map<Timestamp, size_t> counts;
+    registrations.forEach([&counts](const Registration& reg) {
+        if (reg.getRegisteredAt() != INVALID_TIMESTAMP) counts[reg.getRegisteredAt() / 60]++;
+    });
+
+    vector<HourlyCount> hours;
+    hours.reserve(counts.size());
+    for (const auto& [hour, count] : counts) {
+        hours.push_back({hour * 60, count});
+    }
+    sort(hours.begin(), hours.end(),
+         [](const HourlyCount& a, const HourlyCount& b) { return a.hourStart < b.hourStart; });
+    return hours;
+}
@@ -0,0 +1,134 @@
+#include "searchindex.h"
+#include <algorithm>
+#include <cctype>
+
+// ========================================
+// SEARCHINDEX.CPP - Trigram Search Index Implementation
+// ========================================
+// This file implements the SearchIndex class described in searchindex.h.
+// Posting lists are unsorted vectors: adding appends, removing swaps the entry
+// with the last one and pops it, so edits cost O(trigrams x posting length).
+
+// ==================== HELPERS ====================
+
+// Lowercase copy of a text (ASCII only, like toLower() in utils)
+string SearchIndex::fold(string_view text) {
+    string result(text);
+    for (auto& c : result) {
+        c = (char)tolower((unsigned char)c);
+    }
+    return result;
+}
+
+// Distinct trigrams of a text
+// What it does: Packs every run of 3 bytes into one integer, then sorts and
+// removes duplicates so an event appears once per trigram in a posting list
+vector<uint32_t> SearchIndex::trigramsOf(string_view text) {
+    vector<uint32_t> trigrams;
+    if (text.size() < 3) return trigrams;
+
+    trigrams.reserve(text.size() - 2);
+    for (size_t i = 0; i + 3 <= text.size(); i++) {
+        trigrams.push_back(((uint32_t)(unsigned char)text[i] << 16) |
+                           ((uint32_t)(unsigned char)text[i + 1] << 8) |
+                           (uint32_t)(unsigned char)text[i + 2]);
+    }
+    sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void SearchIndex::addPostings(SymbolId eventId, SearchField field, const string& text) {
+    for (uint32_t trigram : trigramsOf(text)) {
+        postings[field][trigram].push_back(eventId);
+    }
+}
+
+void SearchIndex::removePostings(SymbolId eventId, SearchField field, const string& text) {
+    for (uint32_t trigram : trigramsOf(text)) {
+        auto it = postings[field].find(trigram);
+        if (it == postings[field].end()) continue;
+
+        vector<SymbolId>& list = it->second;
+        auto pos = find(list.begin(), list.end(), eventId);
+        if (pos != list.end()) {
+            *pos = list.back();
+            list.pop_back();
+        }
+        if (list.empty()) postings[field].erase(it);
+    }
+}
+
+// ==================== CHANGES ====================
+
+void SearchIndex::clear() {
+    entries.clear();
+    postings[SEARCH_NAME].clear();
+    postings[SEARCH_VENUE].clear();
+}
+
+// Index an event
+// What it does: Removes whatever was indexed for this ID (a rename or a venue
+// change re-adds the event), then stores the lowercase texts and their trigrams
+void SearchIndex::add(SymbolId eventId, const string& name, const string& venue) {
+    remove(eventId);
+
+    Entry& entry = entries[eventId];
+    entry.text[SEARCH_NAME] = fold(name);
+    entry.text[SEARCH_VENUE] = fold(venue);
+    addPostings(eventId, SEARCH_NAME, entry.text[SEARCH_NAME]);
+    addPostings(eventId, SEARCH_VENUE, entry.text[SEARCH_VENUE]);
+}
+
+void SearchIndex::remove(SymbolId eventId) {
+    auto it = entries.find(eventId);
+    if (it == entries.end()) return;
+
+    removePostings(eventId, SEARCH_NAME, it->second.text[SEARCH_NAME]);
+    removePostings(eventId, SEARCH_VENUE, it->second.text[SEARCH_VENUE]);
+    entries.erase(it);
+}
+
+// ==================== QUERIES ====================
+
+// Substring search
+// What it does: Looks up the posting list of every trigram in the query; if one is
+// missing nothing can match. Otherwise only the events in the shortest list are
+// candidates, and each is confirmed with find() (having all trigrams does not
+// guarantee they are next to each other)
+vector<SymbolId> SearchIndex::search(string_view query, SearchField field) const {
+    vector<SymbolId> results;
+    string needle = fold(query);
+    if (needle.empty()) return results;
+
+    // Too short for a trigram - check every stored text
+    if (needle.size() < 3) {
+        for (const auto& [eventId, entry] : entries) {
+            if (entry.text[field].find(needle) != string::npos) {
+                results.push_back(eventId);
+            }
+        }
+        return results;
+    }
+
+    const vector<SymbolId>* shortest = nullptr;
+    for (uint32_t trigram : trigramsOf(needle)) {
+        auto it = postings[field].find(trigram);
+        if (it == postings[field].end()) return results;
+        if (shortest == nullptr || it->second.size() < shortest->size()) {
+            shortest = &it->second;
+        }
+    }
+
+    for (SymbolId eventId : *shortest) {
+        auto it = entries.find(eventId);
+        if (it != entries.end() && it->second.text[field].find(needle) != string::npos) {
+            results.push_back(eventId);
+        }
+    }
+    return results;
+}
+
+size_t SearchIndex::size() const {
+    return entries.size();
+}
@@ -0,0 +1,560 @@
+#include "server.h"
+#include "eventstore.h"
+#include "userdirectory.h"
+#include "verifierpool.h"
+#include "password.h"
+#include "report.h"
+#include "utils.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// ========================================
+// SERVER.CPP - Multi-Client Server Implementation
+// ========================================
+// This file implements server mode: an epoll loop that accepts clients on a Unix
+// socket, and a worker pool that parses their commands and runs them against the
+// shared EventStore (see server.h for the protocol).
+
+static const size_t MAX_LINE_LENGTH = 4096;    // Longer commands are rejected
+static const int MAX_EPOLL_EVENTS = 256;
+static const int EPOLL_TIMEOUT_MS = 200;       // How often run() checks for stop()
+
+ClientConnection::ClientConnection(int socketFd) : fd(socketFd), closing(false) {}
+
+// Write the whole response, waiting briefly whenever the socket buffer is full
+static bool sendAll(int fd, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd waitFor = {fd, POLLOUT, 0};
+            if (poll(&waitFor, 1, 1000) <= 0) return false;    // Client stopped reading
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Split "COMMAND rest of line" into its command word and arguments
+static void splitCommand(const string& line, string& command, string& arguments) {
+    size_t space = line.find(' ');
+    command = line.substr(0, space);
+    arguments = space == string::npos ? "" : trim(line.substr(space + 1));
+    for (auto& c : command) c = toupper((unsigned char)c);
+}
+
+// "OK <n>" followed by n lines
+static string listResponse(const vector<string>& lines) {
+    string response = "OK " + to_string(lines.size()) + "\n";
+    for (const auto& line : lines) {
+        response += line + "\n";
+    }
+    return response;
+}
+
+static string formatPercent(double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f", value);
+    return string(buffer);
+}
+
+// ==================== LIFECYCLE ====================
+
+Server::Server(const string& path, size_t threadCount)
+    : socketPath(path), listenFd(-1), epollFd(-1), workers(threadCount), running(false) {}
+
+// Close every client, the listening socket and the socket file
+Server::~Server() {
+    for (auto& entry : connections) {
+        ::close(entry.first);
+    }
+    connections.clear();
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+// Create the listening socket and the epoll instance
+bool Server::openSocket() {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cout << "Error: Socket path is too long: " << socketPath << endl;
+        return false;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        cout << "Error: Could not create socket!" << endl;
+        return false;
+    }
+
+    unlink(socketPath.c_str());    // Left over from a previous run
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        cout << "Error: Could not listen on " << socketPath << "!" << endl;
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        cout << "Error: Could not create epoll instance!" << endl;
+        return false;
+    }
+
+    epoll_event listenEvent;
+    memset(&listenEvent, 0, sizeof(listenEvent));
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) == 0;
+}
+
+// Main loop
+// What it does: Waits for epoll events; new connections are accepted on this
+// thread, readable clients are handed to the worker pool
+bool Server::run() {
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    UserDirectory::instance().refresh();
+
+    size_t rebuilt = store.takeRebuiltCounts();
+    if (rebuilt > 0) {
+        cout << "Note: Registration counts of " << rebuilt
+             << " event(s) did not match their registrations and were rebuilt." << endl;
+        store.save();
+    }
+
+    if (!openSocket()) return false;
+
+    cout << "Server listening on " << socketPath << " (" << workers.threadCount()
+         << " worker threads)" << endl;
+
+    running = true;
+    epoll_event ready[MAX_EPOLL_EVENTS];
+    while (running) {
+        int count = epoll_wait(epollFd, ready, MAX_EPOLL_EVENTS, EPOLL_TIMEOUT_MS);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            cout << "Error: epoll_wait failed!" << endl;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = ready[i].data.fd;
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+
+            shared_ptr<ClientConnection> client;
+            {
+                lock_guard<mutex> guard(connectionsLock);
+                auto it = connections.find(fd);
+                if (it == connections.end()) continue;
+                client = it->second;
+            }
+            workers.submit([this, client] { serveClient(client); });
+        }
+    }
+
+    // Let in-flight commands finish before the store is flushed
+    workers.wait();
+    store.sync();
+    cout << "Server stopped." << endl;
+    return true;
+}
+
+void Server::stop() {
+    running = false;
+}
+
+// Accept every pending connection
+void Server::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;    // EAGAIN: no more pending connections
+
+        {
+            lock_guard<mutex> guard(connectionsLock);
+            connections[fd] = make_shared<ClientConnection>(fd);
+        }
+
+        // EPOLLONESHOT: after each wake-up the client is disabled until its
+        // worker re-arms it, so two workers never read the same client
+        epoll_event clientEvent;
+        memset(&clientEvent, 0, sizeof(clientEvent));
+        clientEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        clientEvent.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &clientEvent) != 0) {
+            closeClient(fd);
+        }
+    }
+}
+
+void Server::closeClient(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    {
+        lock_guard<mutex> guard(connectionsLock);
+        connections.erase(fd);
+    }
+    ::close(fd);
+}
+
+// ==================== CLIENT HANDLING ====================
+
+// Serve one readable client (runs on a worker thread)
+// What it does: Reads everything available, answers each complete line, then
+// either closes the client or re-arms it in epoll
+void Server::serveClient(const shared_ptr<ClientConnection>& client) {
+    char buffer[4096];
+    while (true) {
+        ssize_t n = recv(client->fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            client->input.append(buffer, n);
+        } else if (n == 0) {
+            client->closing = true;    // Peer hung up
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) client->closing = true;
+            break;
+        }
+    }
+
+    size_t lineStart = 0;
+    size_t newline;
+    while (!client->closing && (newline = client->input.find('\n', lineStart)) != string::npos) {
+        string line = client->input.substr(lineStart, newline - lineStart);
+        lineStart = newline + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (trim(line).empty()) continue;
+
+        if (!sendAll(client->fd, handleCommand(*client, line))) {
+            client->closing = true;
+        }
+    }
+    client->input.erase(0, lineStart);
+
+    if (client->input.size() > MAX_LINE_LENGTH) {
+        sendAll(client->fd, "ERR line too long\n");
+        client->closing = true;
+    }
+
+    if (client->closing) {
+        closeClient(client->fd);
+        return;
+    }
+
+    epoll_event clientEvent;
+    memset(&clientEvent, 0, sizeof(clientEvent));
+    clientEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    clientEvent.data.fd = client->fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, client->fd, &clientEvent) != 0) {
+        closeClient(client->fd);
+    }
+}
+
+// Dispatch one command line
+string Server::handleCommand(ClientConnection& client, const string& line) {
+    string command, arguments;
+    splitCommand(line, command, arguments);
+
+    if (command == "QUIT") {
+        client.closing = true;
+        return "OK bye\n";
+    }
+    if (command == "LOGIN") return handleLogin(client, arguments);
+
+    if (client.username.empty()) return "ERR not logged in\n";
+
+    if (command == "LIST") return handleList();
+    if (command == "MY") return handleMyRegistrations(client);
+
+    if (command == "REGISTER" || command == "UNREGISTER" || command == "WAITLIST" || command == "LEAVE") {
+        if (client.userType != "student") return "ERR students only\n";
+        if (arguments.empty()) return "ERR missing event name\n";
+        if (command == "REGISTER") return handleRegister(client, arguments);
+        if (command == "UNREGISTER") return handleUnregister(client, arguments);
+        if (command == "WAITLIST") return handleWaitlist(client, arguments);
+        return handleLeave(client, arguments);
+    }
+
+    if (command == "SUMMARY" || command == "PARTICIPANTS") {
+        if (client.userType != "admin") return "ERR admins only\n";
+        if (command == "SUMMARY") return handleSummary();
+        if (arguments.empty()) return "ERR missing event name\n";
+        return handleParticipants(arguments);
+    }
+
+    if (command == "ADDEVENT" || command == "EDITEVENT" || command == "DELETEEVENT") {
+        if (client.userType != "admin") return "ERR admins only\n";
+        if (arguments.empty()) return "ERR missing event name\n";
+        lock_guard<mutex> guard(eventsEditLock);
+        if (command == "ADDEVENT") return handleAddEvent(arguments);
+        if (command == "EDITEVENT") return handleEditEvent(arguments);
+        return handleDeleteEvent(arguments);
+    }
+
+    return "ERR unknown command\n";
+}
+
+// ==================== COMMAND HANDLERS ====================
+
+// LOGIN <username> <password>
+// The stored entry is copied under the lock; the slow hash check is done outside it
+string Server::handleLogin(ClientConnection& client, const string& arguments) {
+    string username, password;
+    istringstream words(arguments);
+    words >> username >> password;
+    if (username.empty() || password.empty()) return "ERR usage: LOGIN <username> <password>\n";
+
+    UserRecord user;
+    bool found;
+    {
+        lock_guard<mutex> guard(usersLock);
+        UserDirectory& directory = UserDirectory::instance();
+        directory.refresh();
+        const UserRecord* record = directory.find(username);
+        found = record != nullptr;
+        if (found) user = *record;
+    }
+
+    if (!found || !VerifierPool::instance().verify(user.password, password).get()) {
+        return "ERR invalid credentials\n";
+    }
+
+    // Same upgrade as the console login: plaintext / old-cost entries are re-hashed
+    if (passwordNeedsRehash(user.password)) {
+        string stored = VerifierPool::instance().hash(password).get();
+        lock_guard<mutex> guard(usersLock);
+        UserDirectory::instance().setPassword(user.username, stored);
+    }
+
+    client.username = user.username;
+    client.userType = user.userType;
+    return "OK " + user.userType + "\n";
+}
+
+// LIST
+string Server::handleList() {
+    EventStore& store = EventStore::instance();
+    auto guard = store.readLock();
+    vector<string> lines;
+    for (const auto& event : store.getEvents()) {
+        lines.push_back(event.getEventName() + "|" + event.getDate() + "|" + event.getVenue() + "|" +
+                        to_string(event.getCapacity()) + "|" + to_string(event.getRegisteredCount()));
+    }
+    return listResponse(lines);
+}
+
+// REGISTER <event name>
+// No server lock: the store locks only the event's shard (see eventstore.h)
+string Server::handleRegister(ClientConnection& client, const string& eventName) {
+    RegistrationStatus status =
+        EventStore::instance().registerStudent(client.username, eventName, currentDateTime());
+    if (status != REGISTRATION_OK) return "ERR " + registrationStatusMessage(status) + "\n";
+    return "OK registered\n";
+}
+
+// UNREGISTER <event name>
+string Server::handleUnregister(ClientConnection& client, const string& eventName) {
+    RegistrationStatus status = EventStore::instance().unregisterStudent(client.username, eventName);
+    if (status != REGISTRATION_OK) return "ERR " + registrationStatusMessage(status) + "\n";
+    return "OK unregistered\n";
+}
+
+// WAITLIST <event name>
+// Registers at once if a seat is free, otherwise queues the student (one request
+// instead of polling REGISTER until a seat frees up)
+string Server::handleWaitlist(ClientConnection& client, const string& eventName) {
+    EventStore& store = EventStore::instance();
+    RegistrationStatus status = store.joinWaitlist(client.username, eventName, currentDateTime());
+    if (status == REGISTRATION_OK) return "OK registered\n";
+    if (status != REGISTRATION_WAITLISTED) return "ERR " + registrationStatusMessage(status) + "\n";
+
+    size_t position = store.getRegistrations().waitlistPosition(userSymbols().find(client.username),
+                                                                 eventSymbols().find(eventName));
+    return "OK waitlisted " + to_string(position) + "\n";
+}
+
+// LEAVE <event name>
+string Server::handleLeave(ClientConnection& client, const string& eventName) {
+    RegistrationStatus status = EventStore::instance().leaveWaitlist(client.username, eventName);
+    if (status == REGISTRATION_NOT_FOUND) return "ERR not on the waitlist\n";
+    if (status != REGISTRATION_OK) return "ERR " + registrationStatusMessage(status) + "\n";
+    return "OK left\n";
+}
+
+// MY
+string Server::handleMyRegistrations(ClientConnection& client) {
+    EventStore& store = EventStore::instance();
+    auto guard = store.readLock();
+    vector<string> lines;
+    for (const Registration& reg : store.getRegistrations().forStudent(client.username)) {
+        string line = reg.getEventName();
+        Event* event = store.findEvent(reg.getEventName());
+        if (event != nullptr) {
+            line += "|" + event->getDate() + "|" + event->getVenue();
+        } else {
+            line += "||";
+        }
+        lines.push_back(line + "|" + reg.getRegistrationDate());
+    }
+    return listResponse(lines);
+}
+
+// SUMMARY (same numbers as the admin statistics screen)
+string Server::handleSummary() {
+    EventStore& store = EventStore::instance();
+    auto guard = store.readLock();
+    RegistrationSummary summary = buildRegistrationSummary(store.getEvents(), store.getRegistrations());
+
+    vector<string> lines;
+    for (const auto& row : summary.events) {
+        lines.push_back(row.eventName + "|" + to_string(row.capacity) + "|" +
+                        to_string(row.registered) + "|" + formatPercent(row.occupancy()));
+    }
+    lines.push_back("TOTAL|" + to_string(summary.totalCapacity) + "|" +
+                    to_string(summary.totalRegistered) + "|" + formatPercent(summary.occupancy()));
+    return listResponse(lines);
+}
+
+// PARTICIPANTS <event name>
+string Server::handleParticipants(const string& eventName) {
+    EventStore& store = EventStore::instance();
+    auto guard = store.readLock();
+    if (store.findEvent(eventName) == nullptr) return "ERR no such event\n";
+
+    vector<string> lines;
+    for (const Registration& reg : store.getRegistrations().forEvent(eventName)) {
+        lines.push_back(reg.getStudentUsername() + "|" + reg.getRegistrationDate());
+    }
+    return listResponse(lines);
+}
+
+// ==================== EVENT MANAGEMENT (admin) ====================
+// The handlers below run with eventsEditLock held (see handleCommand)
+
+// Split "a|b|c" into trimmed fields
+static vector<string> splitArguments(const string& arguments) {
+    vector<string> fields = split(arguments, '|');
+    for (auto& field : fields) field = trim(field);
+    return fields;
+}
+
+// Does an event other than 'except' already have this name (case-insensitive,
+// like the admin menu)?
+static bool eventNameTaken(EventStore& store, const string& name, const string& except = "") {
+    auto guard = store.readLock();
+    string wanted = toLower(name);
+    for (const auto& event : store.getEvents()) {
+        if (event.getEventName() != except && toLower(event.getEventName()) == wanted) return true;
+    }
+    return false;
+}
+
+// Write the change back (same as the admin menu after each edit)
+static string saveEvents(EventStore& store, const string& success) {
+    store.markEventsModified();
+    if (!store.save()) return "ERR could not save the change\n";
+    return success;
+}
+
+// ADDEVENT <name>|<date>|<venue>|<capacity>
+// Same checks as Admin::addNewEvent()
+string Server::handleAddEvent(const string& arguments) {
+    vector<string> fields = splitArguments(arguments);
+    int capacity = 0;
+    if (fields.size() != 4) return "ERR usage: ADDEVENT <name>|<date>|<venue>|<capacity>\n";
+    if (fields[0].empty()) return "ERR missing event name\n";
+    if (!isValidDate(fields[1])) return "ERR invalid date (DD-MM-YYYY)\n";
+    if (fields[2].empty()) return "ERR missing venue\n";
+    if (!parseInt(fields[3], capacity) || capacity <= 0) return "ERR capacity must be greater than 0\n";
+
+    EventStore& store = EventStore::instance();
+    if (eventNameTaken(store, fields[0])) return "ERR event already exists\n";
+
+    store.addEvent(Event(fields[0], fields[1], fields[2], capacity, 0));
+    return saveEvents(store, "OK added\n");
+}
+
+// EDITEVENT <name>|name|date|venue|capacity|<value>
+// Same checks as Admin::editEvent(); the store methods keep the indexes up to date
+string Server::handleEditEvent(const string& arguments) {
+    vector<string> fields = splitArguments(arguments);
+    if (fields.size() != 3) return "ERR usage: EDITEVENT <name>|name|date|venue|capacity|<value>\n";
+    string field = toLower(fields[1]);
+    const string& value = fields[2];
+
+    // The event is only ever touched by name: each store call looks it up again
+    // under its own write lock, so no pointer into the catalog outlives a lock
+    EventStore& store = EventStore::instance();
+    const string& eventName = fields[0];
+    bool found;
+
+    if (field == "name") {
+        if (value.empty()) return "ERR missing new name\n";
+        if (eventNameTaken(store, value, eventName)) return "ERR event already exists\n";
+        found = store.renameEvent(eventName, value);
+    } else if (field == "date") {
+        if (!isValidDate(value)) return "ERR invalid date (DD-MM-YYYY)\n";
+        found = store.setEventDate(eventName, value);
+    } else if (field == "venue") {
+        if (value.empty()) return "ERR missing venue\n";
+        found = store.setEventVenue(eventName, value);
+    } else if (field == "capacity") {
+        int capacity = 0;
+        if (!parseInt(value, capacity) || capacity <= 0) return "ERR capacity must be greater than 0\n";
+        {
+            // The write lock also keeps registrations out while the count is compared
+            auto guard = store.writeLock();
+            Event* event = store.findEvent(eventName);
+            if (event == nullptr) return "ERR no such event\n";
+            if (capacity < event->getRegisteredCount()) {
+                return "ERR capacity is below the registered count (" +
+                       to_string(event->getRegisteredCount()) + ")\n";
+            }
+            event->setCapacity(capacity);
+        }
+        size_t promoted = store.promoteWaiters(eventName);
+        return saveEvents(store, "OK updated " + to_string(promoted) + "\n");
+    } else {
+        return "ERR unknown field (name, date, venue or capacity)\n";
+    }
+    if (!found) return "ERR no such event\n";
+    return saveEvents(store, "OK updated\n");
+}
+
+// DELETEEVENT <event name>
+// One journaled record; the event's registrations and waitlist go with it
+string Server::handleDeleteEvent(const string& eventName) {
+    EventStore& store = EventStore::instance();
+    size_t registrationCount;
+    {
+        auto guard = store.readLock();
+        if (store.findEvent(eventName) == nullptr) return "ERR no such event\n";
+        registrationCount = store.getRegistrations().countForEvent(eventName);
+    }
+    if (!store.deleteEvent(eventName)) return "ERR could not delete the event\n";
+    return "OK deleted " + to_string(registrationCount) + "\n";
+}
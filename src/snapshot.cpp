@@ -0,0 +1,227 @@
+#include "snapshot.h"
+#include "eventstore.h"
+#include "utils.h"
+#include "mappedfile.h"
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+
+// ========================================
+// SNAPSHOT.CPP - Binary Snapshot Implementation
+// ========================================
+// This file writes and reads the binary snapshot described in snapshot.h.
+// Fixed-width columns mean loading is just reading arrays out of a memory map;
+// only names and venues are copied out of the string heap.
+
+// ==================== WRITING ====================
+
+// Collects strings into the heap and hands out local symbol IDs
+struct HeapBuilder {
+    string heap;
+    vector<uint32_t> offsets;
+    vector<uint32_t> lengths;
+    unordered_map<SymbolId, uint32_t> localIds;    // Global symbol ID -> ID in this file
+
+    // Add a string to the heap and return its offset
+    uint32_t addString(const string& str) {
+        uint32_t offset = (uint32_t)heap.size();
+        heap += str;
+        return offset;
+    }
+
+    // Local ID for an interned symbol (its name is stored once)
+    uint32_t localId(SymbolId id, const SymbolTable& table) {
+        auto it = localIds.find(id);
+        if (it != localIds.end()) return it->second;
+
+        const string& name = table.name(id);
+        uint32_t local = (uint32_t)offsets.size();
+        offsets.push_back(addString(name));
+        lengths.push_back((uint32_t)name.size());
+        localIds[id] = local;
+        return local;
+    }
+};
+
+// Write one uint32 column
+static void writeColumn(ofstream& file, const vector<uint32_t>& column) {
+    file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(uint32_t));
+}
+
+// Write a binary snapshot
+// What it does: Turns every field into a fixed-width column, names into local symbol
+// IDs and all text into one string heap, then writes it all in one go
+bool writeSnapshot(const string& path, const vector<Event>& events,
+                   const vector<Registration>& registrations) {
+    HeapBuilder users;
+    HeapBuilder eventNames;
+    string venueHeap;
+
+    // ----- event columns -----
+    size_t eventCount = events.size();
+    vector<uint32_t> nameId(eventCount), venueOffset(eventCount), venueLength(eventCount);
+    vector<uint32_t> date(eventCount), capacity(eventCount), registered(eventCount);
+    for (size_t i = 0; i < eventCount; i++) {
+        const Event& event = events[i];
+        nameId[i] = eventNames.localId(eventSymbols().intern(event.getEventName()), eventSymbols());
+        venueOffset[i] = (uint32_t)venueHeap.size();
+        venueLength[i] = (uint32_t)event.getVenue().size();
+        venueHeap += event.getVenue();
+        date[i] = packDate(event.getDate());
+        capacity[i] = (uint32_t)event.getCapacity();
+        registered[i] = (uint32_t)event.getRegisteredCount();
+    }
+
+    // ----- registration columns -----
+    size_t registrationCount = registrations.size();
+    vector<uint32_t> studentId(registrationCount), eventId(registrationCount);
+    vector<uint32_t> registeredAt(registrationCount);
+    for (size_t i = 0; i < registrationCount; i++) {
+        const Registration& reg = registrations[i];
+        studentId[i] = users.localId(reg.getStudentId(), userSymbols());
+        eventId[i] = eventNames.localId(reg.getEventId(), eventSymbols());
+        registeredAt[i] = reg.getRegisteredAt();
+    }
+
+    // ----- one string heap: usernames, then event names, then venues -----
+    uint32_t eventNamesBase = (uint32_t)users.heap.size();
+    uint32_t venuesBase = eventNamesBase + (uint32_t)eventNames.heap.size();
+    for (auto& offset : eventNames.offsets) offset += eventNamesBase;
+    for (auto& offset : venueOffset) offset += venuesBase;
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.eventCount = (uint32_t)eventCount;
+    header.registrationCount = (uint32_t)registrationCount;
+    header.userCount = (uint32_t)users.offsets.size();
+    header.eventNameCount = (uint32_t)eventNames.offsets.size();
+    header.reserved = 0;
+    header.heapSize = users.heap.size() + eventNames.heap.size() + venueHeap.size();
+
+    string tempPath = path + ".tmp";
+    ofstream file(tempPath, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open " << path << " for writing!" << endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto* column : {&nameId, &venueOffset, &venueLength, &date, &capacity, &registered,
+                               &studentId, &eventId, &registeredAt,
+                               &users.offsets, &users.lengths,
+                               &eventNames.offsets, &eventNames.lengths}) {
+        writeColumn(file, *column);
+    }
+    file << users.heap << eventNames.heap << venueHeap;
+
+    file.close();
+    if (file.fail()) return false;
+    return replaceFileDurably(tempPath, path);
+}
+
+// ==================== READING ====================
+
+// Load a binary snapshot
+// What it does: Maps the file into memory, checks the header and sizes, re-interns the
+// file's names once each, then builds events and registrations straight from the columns
+bool readSnapshot(const string& path, vector<Event>& events, RegistrationIndex& registrations) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(SnapshotHeader)) return false;
+
+    size_t fileSize = file.size();
+    const char* base = file.view().data();
+    SnapshotHeader header;
+    memcpy(&header, base, sizeof(header));
+
+    // Validate the header and that the columns + heap exactly fill the file
+    uint64_t E = header.eventCount, R = header.registrationCount;
+    uint64_t U = header.userCount, N = header.eventNameCount;
+    uint64_t expected = sizeof(header) + 4 * (6 * E + 3 * R + 2 * U + 2 * N) + header.heapSize;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION || expected != fileSize) {
+        cerr << "Error: " << path << " is not a valid snapshot!" << endl;
+        return false;
+    }
+
+    // Column pointers (the header is 40 bytes, so every column is 4-byte aligned)
+    const uint32_t* column = reinterpret_cast<const uint32_t*>(base + sizeof(header));
+    const uint32_t* nameId = column;            column += E;
+    const uint32_t* venueOffset = column;       column += E;
+    const uint32_t* venueLength = column;       column += E;
+    const uint32_t* date = column;              column += E;
+    const uint32_t* capacity = column;          column += E;
+    const uint32_t* registered = column;        column += E;
+    const uint32_t* studentId = column;         column += R;
+    const uint32_t* eventId = column;           column += R;
+    const uint32_t* registeredAt = column;      column += R;
+    const uint32_t* userOffset = column;        column += U;
+    const uint32_t* userLength = column;        column += U;
+    const uint32_t* eventOffset = column;       column += N;
+    const uint32_t* eventLength = column;       column += N;
+    const char* heap = reinterpret_cast<const char*>(column);
+
+    bool valid = true;
+    auto heapString = [&](uint32_t offset, uint32_t length) {
+        if ((uint64_t)offset + length > header.heapSize) {
+            valid = false;
+            return string();
+        }
+        return string(heap + offset, length);
+    };
+
+    // Local IDs in the file -> IDs in this process
+    vector<SymbolId> users(U), eventNames(N);
+    for (uint64_t i = 0; i < U; i++) {
+        users[i] = userSymbols().intern(heapString(userOffset[i], userLength[i]));
+    }
+    for (uint64_t i = 0; i < N; i++) {
+        eventNames[i] = eventSymbols().intern(heapString(eventOffset[i], eventLength[i]));
+    }
+
+    events.reserve(events.size() + E);
+    for (uint64_t i = 0; i < E && valid; i++) {
+        if (nameId[i] >= N) { valid = false; break; }
+        events.push_back(Event(eventSymbols().name(eventNames[nameId[i]]), formatDate(date[i]),
+                               heapString(venueOffset[i], venueLength[i]),
+                               (int)capacity[i], (int)registered[i]));
+    }
+
+    for (uint64_t i = 0; i < R && valid; i++) {
+        if (studentId[i] >= U || eventId[i] >= N) { valid = false; break; }
+        registrations.add(Registration(users[studentId[i]], eventNames[eventId[i]], registeredAt[i]));
+    }
+
+    if (!valid) {
+        cerr << "Error: " << path << " is corrupted!" << endl;
+    }
+    return valid;
+}
+
+// ==================== CONVERTERS ====================
+
+// Text files -> binary snapshot
+bool convertTextToSnapshot(const string& eventsPath, const string& registrationsPath,
+                           const string& snapshotPath) {
+    vector<Event> events;
+    RegistrationIndex registrations;
+    if (!EventStore::readEventsFile(eventsPath, events) ||
+        !EventStore::readRegistrationsFile(registrationsPath, registrations)) {
+        return false;
+    }
+    return writeSnapshot(snapshotPath, events, registrations.toVector());
+}
+
+// Binary snapshot -> text files
+bool convertSnapshotToText(const string& snapshotPath, const string& eventsPath,
+                           const string& registrationsPath) {
+    vector<Event> events;
+    RegistrationIndex registrations;
+    if (!readSnapshot(snapshotPath, events, registrations)) {
+        return false;
+    }
+    return EventStore::writeEventsFile(eventsPath, events) &&
+           EventStore::writeRegistrationsFile(registrationsPath, registrations.toVector());
+}
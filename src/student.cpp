@@ -32,118 +32,23 @@ string Student::getUserType() {
     return "Student";
 }
 
-// ==================== FILE I/O OPERATIONS ====================
-// Students need to read/write events and registrations files
-// These functions are similar to Admin's but Student doesn't have extra features
-
-// Load events from file
-// What it does: Reads events.txt and creates Event objects
-// Why students need this: To browse available events
-vector<Event> Student::loadEventsFromFile() {
-    vector<Event> events;
-    ifstream file("data/events.txt");
-    string line;
-    
-    if (!file.is_open()) {
-        return events;    // Return empty vector if file doesn't exist
-    }
-    
-    // Read and parse each line
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        vector<string> parts = split(line, '|');
-        if (parts.size() >= 4) {
-            string name = trim(parts[0]);
-            string date = trim(parts[1]);
-            string venue = trim(parts[2]);
-            int capacity = stoi(trim(parts[3]));
-            int registered = (parts.size() > 4) ? stoi(trim(parts[4])) : 0;
-            
-            events.push_back(Event(name, date, venue, capacity, registered));
-        }
-    }
-    
-    file.close();
-    return events;
-}
-
-// Save events to file
-// What it does: Writes updated events back to file
-// Why students need this: When they register/unregister, the registered count changes
-bool Student::saveEventsToFile(const vector<Event>& events) {
-    ofstream file("data/events.txt");
-    
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    for (const auto& event : events) {
-        file << event.toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
-}
-
-// Load registrations from file
-// What it does: Reads all registrations to check what events user is registered for
-vector<Registration> Student::loadRegistrationsFromFile() {
-    vector<Registration> registrations;
-    ifstream file("data/registrations.txt");
-    string line;
-    
-    if (!file.is_open()) {
-        return registrations;
-    }
-    
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        vector<string> parts = split(line, '|');
-        if (parts.size() == 3) {
-            registrations.push_back(Registration(trim(parts[0]), trim(parts[1]), trim(parts[2])));
-        }
-    }
-    
-    file.close();
-    return registrations;
-}
-
-// Save registrations to file
-// What it does: Writes updated registrations back to file
-// Called when: Student registers or unregisters from an event
-bool Student::saveRegistrationsToFile(const vector<Registration>& registrations) {
-    ofstream file("data/registrations.txt");
-    
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    for (const auto& reg : registrations) {
-        file << reg.toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
-}
+// ==================== DATA ACCESS ====================
+// Students read and update the shared EventStore (see eventstore.cpp) instead of
+// re-reading events.txt and registrations.txt on every action.
 
 // Get current date and time
 // What it does: Returns current system date/time as a formatted string
 // Used when: Recording when a student registered for an event
 // Returns: String in format "DD-MM-YYYY HH:MM"
 string Student::getCurrentDateTime() {
-    time_t now = time(0);                  // Get current time as seconds since epoch
-    tm* timeinfo = localtime(&now);         // Convert to local time structure
-    char buffer[20];                        // Character array to hold formatted string
-    // strftime formats the time according to the format string
-    strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M", timeinfo);
-    return string(buffer);                  // Convert char array to string
+    return currentDateTime();               // See utils.cpp
 }
 
 // View available events for registration
 void Student::viewAvailableEvents() {
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    const vector<Event>& events = store.getEvents();
     
     cout << "\n=== AVAILABLE EVENTS FOR REGISTRATION ===" << endl;
     
@@ -170,19 +75,17 @@ void Student::viewAvailableEvents() {
 
 // View my registrations
 void Student::viewMyRegistrations() {
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
     
     cout << "\n=== MY REGISTRATIONS ===" << endl;
     
-    vector<Registration> myRegs;
-    for (const auto& reg : registrations) {
-        if (reg.getStudentUsername() == username) {
-            myRegs.push_back(reg);
-        }
-    }
+    // The per-student posting list gives this student's registrations directly (O(k))
+    // A copy, so unregistering below does not change the list being shown
+    vector<Registration> myRegs = store.getRegistrations().forStudent(username);
+    vector<Registration> myWaits = store.getRegistrations().waitlistForStudent(username);
     
-    if (myRegs.empty()) {
+    if (myRegs.empty() && myWaits.empty()) {
         cout << "You are not registered for any events!" << endl;
         return;
     }
@@ -196,10 +99,24 @@ void Student::viewMyRegistrations() {
              << " (Registered: " << myRegs[i].getRegistrationDate() << ")" << endl;
     }
     
+    // Waitlists (registered automatically when a seat frees up)
+    if (!myWaits.empty()) {
+        cout << "\nYou are on " << myWaits.size() << " waitlist(s):" << endl;
+        for (size_t i = 0; i < myWaits.size(); i++) {
+            size_t position = store.getRegistrations().waitlistPosition(myWaits[i].getStudentId(),
+                                                                        myWaits[i].getEventId());
+            cout << i + 1 << ". " << myWaits[i].getEventName() << " (#" << position
+                 << " in line, joined: " << myWaits[i].getRegistrationDate() << ")" << endl;
+        }
+    }
+    
     cout << "\nOptions:" << endl;
     cout << "1. View Event Details" << endl;
     cout << "2. Unregister from Event" << endl;
     cout << "3. Back" << endl;
+    if (!myWaits.empty()) {
+        cout << "4. Leave a Waitlist" << endl;
+    }
     cout << "Choose option: ";
     
     int choice;
@@ -213,11 +130,9 @@ void Student::viewMyRegistrations() {
         cin.ignore();
         
         if (eventNum >= 1 && eventNum <= (int)myRegs.size()) {
-            for (const auto& event : events) {
-                if (event.getEventName() == myRegs[eventNum - 1].getEventName()) {
-                    event.displayDetailed(eventNum);
-                    break;
-                }
+            const Event* event = store.findEvent(myRegs[eventNum - 1].getEventName());
+            if (event != nullptr) {
+                event->displayDetailed(eventNum);
             }
         }
     } else if (choice == 2) {
@@ -229,6 +144,20 @@ void Student::viewMyRegistrations() {
         if (eventNum >= 1 && eventNum <= (int)myRegs.size()) {
             unregisterFromEvent(myRegs[eventNum - 1].getEventName());
         }
+    } else if (choice == 4 && !myWaits.empty()) {
+        cout << "Enter waitlist number to leave: ";
+        int waitNum;
+        cin >> waitNum;
+        cin.ignore();
+        
+        if (waitNum >= 1 && waitNum <= (int)myWaits.size()) {
+            string eventName = myWaits[waitNum - 1].getEventName();
+            if (store.leaveWaitlist(username, eventName) == REGISTRATION_OK) {
+                cout << "You have left the waitlist for '" << eventName << "'." << endl;
+            } else {
+                cout << "Error: You are not on that waitlist!" << endl;
+            }
+        }
     }
 }
 
@@ -238,9 +167,10 @@ void Student::viewMyRegistrations() {
 // What it does: Allows student to sign up for an event
 // Process: Load data → Show events → Get choice → Validate → Update files
 void Student::registerForEvent() {
-    // Load current data from files
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    // Get the shared in-memory data (re-read only if the files changed on disk)
+    EventStore& store = EventStore::instance();
+    store.refresh();
+    vector<Event>& events = store.getEvents();
     
     // Check if there are any events to register for
     if (events.empty()) {
@@ -263,39 +193,56 @@ void Student::registerForEvent() {
         return;
     }
     
-    // Get reference to the selected event (arrays/vectors are 0-indexed, display is 1-indexed)
-    Event& selectedEvent = events[eventNum - 1];
-    string eventName = selectedEvent.getEventName();
+    // Get the selected event's name (arrays/vectors are 0-indexed, display is 1-indexed)
+    string eventName = events[eventNum - 1].getEventName();
     
-    // VALIDATION 1: Check if already registered
-    // Loop through all registrations to see if this student already registered for this event
-    for (const auto& reg : registrations) {
-        if (reg.getStudentUsername() == username && reg.getEventName() == eventName) {
-            cout << "Error: You are already registered for this event!" << endl;
-            return;    // Exit early if duplicate found
-        }
-    }
+    // Validation (duplicate, capacity) and the journaled write happen in the store
+    // The store appends one record to the registration log, adds the Registration
+    // to memory and increments the event's registered count
+    // 'username' is inherited from User base class
+    RegistrationStatus status = store.registerStudent(username, eventName, getCurrentDateTime());
     
-    // VALIDATION 2: Check if event has capacity
-    if (!selectedEvent.hasAvailableSeats()) {
+    if (status == REGISTRATION_OK) {
+        cout << "\nSuccess! You have been registered for '" << eventName << "'!" << endl;
+    } else if (status == REGISTRATION_DUPLICATE) {
+        cout << "Error: You are already registered for this event!" << endl;
+    } else if (status == REGISTRATION_FULL) {
         cout << "Error: Event is full! No available seats." << endl;
+        offerWaitlist(eventName);
+    } else {
+        cout << "Error: Registration failed!" << endl;
+    }
+}
+
+// Offer a place on a full event's waitlist
+// What it does: One enqueue instead of retrying - the student is registered
+// automatically when someone unregisters or the capacity is raised
+void Student::offerWaitlist(const string& eventName) {
+    EventStore& store = EventStore::instance();
+    RegistrationIndex& registrations = store.getRegistrations();
+    SymbolId studentId = userSymbols().intern(username);
+    SymbolId eventId = eventSymbols().intern(eventName);
+    
+    if (registrations.isWaiting(studentId, eventId)) {
+        cout << "You are already #" << registrations.waitlistPosition(studentId, eventId)
+             << " on the waitlist for this event." << endl;
         return;
     }
     
-    // All validations passed - proceed with registration
-    // Step 1: Increment the registered count for the event
-    selectedEvent.registerStudent();
-    
-    // Step 2: Create a new Registration object and add it to the vector
-    // 'username' is inherited from User base class
-    registrations.push_back(Registration(username, eventName, getCurrentDateTime()));
-    
-    // Step 3: Save both updated vectors back to files
-    // && means "and" - both saves must succeed
-    if (saveEventsToFile(events) && saveRegistrationsToFile(registrations)) {
-        cout << "\nSuccess! You have been registered for '" << eventName << "'!" << endl;
+    cout << "Join the waitlist? (y/n): ";
+    string answer;
+    getline(cin, answer);
+    if (toLower(trim(answer)) != "y") return;
+    
+    RegistrationStatus status = store.joinWaitlist(username, eventName, getCurrentDateTime());
+    if (status == REGISTRATION_WAITLISTED) {
+        cout << "You are #" << registrations.waitlistPosition(studentId, eventId)
+             << " on the waitlist for '" << eventName << "'." << endl;
+        cout << "You will be registered automatically when a seat frees up." << endl;
+    } else if (status == REGISTRATION_OK) {
+        cout << "\nSuccess! A seat freed up - you have been registered for '" << eventName << "'!" << endl;
     } else {
-        cout << "Error: Registration failed!" << endl;
+        cout << "Error: Could not join the waitlist (" << registrationStatusMessage(status) << ")!" << endl;
     }
 }
 
@@ -303,43 +250,19 @@ void Student::registerForEvent() {
 // What it does: Removes a student's registration from an event
 // Process: Find the registration → Remove it → Update event count → Save files
 void Student::unregisterFromEvent(const string& eventName) {
-    // Load current data
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
-    
-    // Find and remove registration using find_if algorithm
-    // find_if searches for the first element that matches the condition
-    // LAMBDA FUNCTION: [this, &eventName](const Registration& r) { ... }
-    // - [this, &eventName] = capture clause (what variables from outside the lambda can be used)
-    // - (const Registration& r) = parameter (each Registration as it's checked)
-    // - { return ... } = function body that returns true if this is the registration to remove
-    auto it = find_if(registrations.begin(), registrations.end(),
-        [this, &eventName](const Registration& r) {
-            return r.getStudentUsername() == username && r.getEventName() == eventName;
-        });
-    
-    // Check if registration was found
-    // If find_if doesn't find anything, it returns registrations.end()
-    if (it == registrations.end()) {
-        cout << "Error: Registration not found!" << endl;
-        return;
-    }
+    // Get the shared in-memory data
+    EventStore& store = EventStore::instance();
+    store.refresh();
     
-    // Remove the registration from the vector
-    // 'it' is an iterator (like a pointer) to the element we want to remove
-    registrations.erase(it);
-    
-    // Find the event and decrease its registered count
-    for (auto& event : events) {
-        if (event.getEventName() == eventName) {
-            event.unregisterStudent();    // Decrements registeredCount
-            break;    // Found the event, no need to continue looping
-        }
-    }
+    // Remove the registration: the store checks it exists (one hash lookup), appends
+    // one record to the registration log, erases it from memory and decrements the
+    // event's registered count
+    RegistrationStatus status = store.unregisterStudent(username, eventName);
     
-    // Save updated data back to files
-    if (saveEventsToFile(events) && saveRegistrationsToFile(registrations)) {
+    if (status == REGISTRATION_OK) {
         cout << "Success! You have been unregistered from '" << eventName << "'!" << endl;
+    } else if (status == REGISTRATION_NOT_FOUND) {
+        cout << "Error: Registration not found!" << endl;
     } else {
         cout << "Error: Unregistration failed!" << endl;
     }
@@ -351,10 +274,11 @@ void Student::unregisterFromEvent(const string& eventName) {
 // What it does: Finds events whose names contain the search term (case-insensitive)
 // Example: Searching "tech" will find "Tech Fest 2025" and "Robotech Workshop"
 void Student::searchEventByName() {
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
     
     cout << "\n=== SEARCH EVENTS ===" << endl;
-    cout << "Enter event name to search: ";
+    cout << "Enter event name or venue to search: ";
     
     // Get search term from user
     string searchTerm;
@@ -367,13 +291,12 @@ void Student::searchEventByName() {
         return;
     }
     
-    // Search through events and collect matching ones
-    vector<Event> results;    // Vector to store matching events
-    for (const auto& event : events) {
-        // find() returns string::npos if the substring is not found
-        // So if find() doesn't return npos, it means the search term was found
-        if (toLower(event.getEventName()).find(searchTerm) != string::npos) {
-            results.push_back(event);    // Add matching event to results
+    // Look the term up in the store's trigram index (no scan over every event)
+    // Events whose name matches come first, then those matching only by venue
+    vector<Event*> results = store.searchEvents(searchTerm, SEARCH_NAME);
+    for (Event* event : store.searchEvents(searchTerm, SEARCH_VENUE)) {
+        if (find(results.begin(), results.end(), event) == results.end()) {
+            results.push_back(event);
         }
     }
     
@@ -400,41 +323,90 @@ void Student::searchEventByName() {
     // Display each matching event
     // size_t is an unsigned integer type for sizes/counts
     for (size_t i = 0; i < results.size(); i++) {
-        results[i].display(i + 1);    // Display with 1-based numbering
+        results[i]->display(i + 1);    // Display with 1-based numbering
     }
     cout << string(110, '=') << endl;
     cout << "Found " << results.size() << " event(s)" << endl << endl;
 }
 
+// Read a DD-MM-YYYY date from the user and return its day number
+// Returns: INVALID_DAY (after printing a message) if the input is not a valid date
+static int32_t readDay(const string& prompt) {
+    cout << prompt;
+    string input;
+    getline(cin, input);
+    input = trim(input);
+    
+    if (!isValidDate(input)) {
+        cout << "Invalid date format!" << endl;
+        return INVALID_DAY;
+    }
+    return dayNumber(input);
+}
+
 // Filter events by date
+// What it does: Exact date, date range, next 7 days or everything upcoming.
+// All four are range lookups in the store's sorted date index, so only the
+// matching events are visited and they come out in date order
 void Student::filterEventsByDate() {
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    store.refresh();
     
     cout << "\n=== FILTER EVENTS BY DATE ===" << endl;
-    cout << "Enter date (DD-MM-YYYY): ";
-    
-    string searchDate;
-    getline(cin, searchDate);
-    searchDate = trim(searchDate);
+    cout << "1. On a Date" << endl;
+    cout << "2. Between Two Dates" << endl;
+    cout << "3. Next 7 Days" << endl;
+    cout << "4. All Upcoming Events" << endl;
+    cout << "Choose option: ";
     
-    if (!isValidDate(searchDate)) {
-        cout << "Invalid date format!" << endl;
-        return;
-    }
+    int choice;
+    cin >> choice;
+    cin.ignore();
     
-    vector<Event> results;
-    for (const auto& event : events) {
-        if (event.getDate() == searchDate) {
-            results.push_back(event);
+    vector<Event*> results;
+    string title;
+    switch (choice) {
+        case 1: {
+            int32_t day = readDay("Enter date (DD-MM-YYYY): ");
+            if (day == INVALID_DAY) return;
+            results = store.eventsBetween(day, day);
+            title = "EVENTS ON " + formatDayNumber(day);
+            break;
+        }
+        case 2: {
+            int32_t firstDay = readDay("From (DD-MM-YYYY): ");
+            if (firstDay == INVALID_DAY) return;
+            int32_t lastDay = readDay("To (DD-MM-YYYY): ");
+            if (lastDay == INVALID_DAY) return;
+            if (lastDay < firstDay) {
+                cout << "Error: The end date is before the start date!" << endl;
+                return;
+            }
+            results = store.eventsBetween(firstDay, lastDay);
+            title = "EVENTS FROM " + formatDayNumber(firstDay) + " TO " + formatDayNumber(lastDay);
+            break;
+        }
+        case 3: {
+            int32_t today = todayDayNumber();
+            results = store.eventsBetween(today, today + 6);
+            title = "EVENTS IN THE NEXT 7 DAYS";
+            break;
         }
+        case 4:
+            results = store.upcomingEvents();
+            title = "UPCOMING EVENTS";
+            break;
+        default:
+            cout << "Invalid choice!" << endl;
+            return;
     }
     
     if (results.empty()) {
-        cout << "No events found on " << searchDate << "!" << endl;
+        cout << "No events found!" << endl;
         return;
     }
     
-    cout << "\n=== EVENTS ON " << searchDate << " ===" << endl;
+    cout << "\n=== " << title << " ===" << endl;
     cout << "\n" << string(110, '=') << endl;
     cout << "  " << left << setw(2) << "#" << "  "
          << setw(25) << "EVENT NAME" << " | "
@@ -446,7 +418,7 @@ void Student::filterEventsByDate() {
     cout << string(110, '=') << endl;
     
     for (size_t i = 0; i < results.size(); i++) {
-        results[i].display(i + 1);
+        results[i]->display(i + 1);
     }
     cout << string(110, '=') << endl;
     cout << "Found " << results.size() << " event(s)" << endl << endl;
@@ -0,0 +1,96 @@
+#include "symboltable.h"
+#include <mutex>
+
+// ========================================
+// SYMBOLTABLE.CPP - Symbol Interning Implementation
+// ========================================
+// This file implements SymbolTable, the string <-> integer ID dictionary used to
+// keep registrations small: a Registration stores two IDs instead of two strings.
+
+SymbolTable::SymbolTable() : count(0) {
+    for (auto& chunk : chunks) {
+        chunk.store(nullptr, memory_order_relaxed);
+    }
+}
+
+SymbolTable::~SymbolTable() {
+    for (auto& chunk : chunks) {
+        delete[] chunk.load();
+    }
+}
+
+// The stored string for an ID (its chunk must exist)
+string& SymbolTable::slot(SymbolId id) const {
+    return chunks[id >> CHUNK_BITS].load(memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+}
+
+// Intern a name
+// What it does: Returns the existing ID, or stores the name and returns its new ID.
+// The common case (name already known) only takes the shared lock.
+// The map key is a view of the stored copy, which never moves.
+SymbolId SymbolTable::intern(string_view name) {
+    {
+        shared_lock<shared_mutex> reading(lock);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+    }
+
+    unique_lock<shared_mutex> writing(lock);
+    auto it = ids.find(name);    // Another thread may have added it meanwhile
+    if (it != ids.end()) return it->second;
+
+    SymbolId id = count.load(memory_order_relaxed);
+    size_t chunk = id >> CHUNK_BITS;
+    if (chunks[chunk].load(memory_order_relaxed) == nullptr) {
+        chunks[chunk].store(new string[CHUNK_SIZE], memory_order_release);
+    }
+    slot(id).assign(name);
+    ids[slot(id)] = id;
+    count.store(id + 1, memory_order_release);    // Publish only once the name is in place
+    return id;
+}
+
+SymbolId SymbolTable::find(string_view name) const {
+    shared_lock<shared_mutex> reading(lock);
+    auto it = ids.find(name);
+    return it == ids.end() ? NO_SYMBOL : it->second;
+}
+
+const string& SymbolTable::name(SymbolId id) const {
+    static const string unknown;
+    return id < count.load(memory_order_acquire) ? slot(id) : unknown;
+}
+
+// Rename an ID
+// What it does: Updates the ID's stored name and points the new name at this ID
+void SymbolTable::rename(SymbolId id, const string& newName) {
+    unique_lock<shared_mutex> writing(lock);
+    if (id >= count.load()) return;
+
+    string& stored = slot(id);
+    auto old = ids.find(stored);
+    if (old != ids.end() && old->second == id) {
+        ids.erase(old);
+    }
+    stored = newName;
+
+    // Replace any entry for the new name so its key views this ID's own string
+    ids.erase(string_view(stored));
+    ids.emplace(stored, id);
+}
+
+size_t SymbolTable::size() const {
+    return count.load();
+}
+
+// ==================== SHARED DICTIONARIES ====================
+
+SymbolTable& userSymbols() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable& eventSymbols() {
+    static SymbolTable table;
+    return table;
+}
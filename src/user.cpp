@@ -1,4 +1,5 @@
 #include "user.h"
+#include "password.h"
 
 // ========================================
 // USER.CPP - Base User Class Implementation
@@ -27,9 +28,11 @@ string User::getFullName() const {
 
 // Authentication method
 // What it does: Checks if the provided password matches the stored password
+// The stored password is a salted hash (see password.h), so the entered one is hashed
+// the same way and compared; legacy plaintext entries are compared directly
 // Returns: true if passwords match, false otherwise
 bool User::authenticate(string pass) {
-    return password == pass;   // Compare the provided password with stored password
+    return verifyPassword(password, pass);
 }
 
 // Virtual destructor for proper cleanup
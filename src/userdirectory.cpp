@@ -0,0 +1,192 @@
+#include "userdirectory.h"
+#include "mappedfile.h"
+#include "password.h"
+#include "verifierpool.h"
+#include <future>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// ========================================
+// USERDIRECTORY.CPP - User Directory Implementation
+// ========================================
+// This file implements UserDirectory: users.txt is loaded once into a vector plus a
+// hash map keyed by username, and re-read only when the file changes on disk.
+
+// Constructor
+UserDirectory::UserDirectory(const string& dataDir)
+    : usersPath(dataDir + "/users.txt"), loaded(false) {}
+
+// The process-wide directory
+UserDirectory& UserDirectory::instance() {
+    static UserDirectory directory;
+    return directory;
+}
+
+// ==================== FILE I/O OPERATIONS ====================
+
+// Remember where a user is; the first line with a username wins
+void UserDirectory::indexUser(size_t position) {
+    indexByName.emplace(users[position].username, position);
+}
+
+// Read users.txt
+// File format: username,password,fullname,usertype
+bool UserDirectory::loadFromFile() {
+    users.clear();
+    indexByName.clear();
+
+    bool opened = forEachLine(usersPath, [this](string_view line) {
+        string_view fields[4];
+        if (splitFields(line, ',', fields, 4) >= 4) {
+            users.push_back(UserRecord{string(trimView(fields[0])), string(trimView(fields[1])),
+                                       string(trimView(fields[2])), string(trimView(fields[3]))});
+            indexUser(users.size() - 1);
+        }
+    });
+
+    usersStamp = getFileStamp(usersPath);
+    loaded = opened;
+    return opened;
+}
+
+// Write every user to users.txt
+// What it does: Writes "<path>.tmp" and renames it over users.txt, so a concurrent
+// login never reads a half-written file
+bool UserDirectory::writeFile() {
+    string tempPath = usersPath + ".tmp";
+    ofstream file(tempPath);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open users.txt for writing!" << endl;
+        return false;
+    }
+    for (const auto& user : users) {
+        file << user.username << "," << user.password << "," << user.fullName << ","
+             << user.userType << endl;
+    }
+    file.close();
+    if (file.fail() || !replaceFileDurably(tempPath, usersPath)) {
+        cerr << "Error: Could not write users.txt!" << endl;
+        return false;
+    }
+
+    usersStamp = getFileStamp(usersPath);
+    return true;
+}
+
+// ==================== CACHE MANAGEMENT ====================
+
+// Reload users.txt if its stamp differs from the one we loaded
+bool UserDirectory::refresh() {
+    if (loaded && getFileStamp(usersPath) == usersStamp) {
+        return true;
+    }
+    return loadFromFile();
+}
+
+// ==================== LOOKUPS ====================
+
+const UserRecord* UserDirectory::find(const string& username) const {
+    auto it = indexByName.find(username);
+    return it == indexByName.end() ? nullptr : &users[it->second];
+}
+
+bool UserDirectory::contains(const string& username) const {
+    return indexByName.count(username) > 0;
+}
+
+const vector<UserRecord>& UserDirectory::getUsers() const {
+    return users;
+}
+
+size_t UserDirectory::size() const {
+    return users.size();
+}
+
+// ==================== UPDATES ====================
+
+// Add a user
+// What it does: Appends one line to users.txt, then adds the user to the in-memory
+// copy and re-stamps the file so our own write does not trigger a reload
+bool UserDirectory::addUser(const UserRecord& user) {
+    if (contains(user.username)) return false;
+
+    // Only re-stamp afterwards if nobody else changed the file since we read it
+    bool upToDate = loaded && usersStamp == getFileStamp(usersPath);
+
+    ofstream file(usersPath, ios::app);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open users.txt for writing!" << endl;
+        return false;
+    }
+    file << user.username << "," << user.password << "," << user.fullName << ","
+         << user.userType << endl;
+    file.close();
+    if (file.fail()) return false;
+
+    users.push_back(user);
+    indexUser(users.size() - 1);
+    if (upToDate) usersStamp = getFileStamp(usersPath);
+    return true;
+}
+
+// Append a batch of users
+// What it does: Builds all the lines in memory and appends them with one write
+bool UserDirectory::addUsers(const vector<UserRecord>& newUsers) {
+    for (const auto& user : newUsers) {
+        if (contains(user.username)) return false;
+    }
+
+    bool upToDate = loaded && usersStamp == getFileStamp(usersPath);
+
+    string lines;
+    for (const auto& user : newUsers) {
+        lines += user.username + "," + user.password + "," + user.fullName + "," + user.userType + "\n";
+    }
+
+    ofstream file(usersPath, ios::app);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open users.txt for writing!" << endl;
+        return false;
+    }
+    file << lines;
+    file.close();
+    if (file.fail()) return false;
+
+    for (const auto& user : newUsers) {
+        users.push_back(user);
+        indexUser(users.size() - 1);
+    }
+    if (upToDate) usersStamp = getFileStamp(usersPath);
+    return true;
+}
+
+// Replace one user's password entry
+bool UserDirectory::setPassword(const string& username, const string& stored) {
+    auto it = indexByName.find(username);
+    if (it == indexByName.end()) return false;
+
+    users[it->second].password = stored;
+    return writeFile();
+}
+
+// Re-hash every entry that needs it
+// What it does: Queues one hash per plaintext/outdated entry on the verifier pool
+// (they run in parallel), collects the results, then writes users.txt once.
+// A plaintext entry's password IS its stored text, so it can be hashed directly;
+// an entry hashed at another cost cannot be re-hashed without the password and
+// is left for the next login.
+size_t UserDirectory::migratePasswords() {
+    vector<pair<size_t, future<string>>> pending;
+    for (size_t i = 0; i < users.size(); i++) {
+        if (!isHashedPassword(users[i].password)) {
+            pending.emplace_back(i, VerifierPool::instance().hash(users[i].password));
+        }
+    }
+
+    for (auto& entry : pending) {
+        users[entry.first].password = entry.second.get();
+    }
+    if (!pending.empty() && !writeFile()) return 0;
+    return pending.size();
+}
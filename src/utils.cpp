@@ -1,4 +1,10 @@
 #include "utils.h"
+#include "dateparse.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <charconv>
 
 // ========================================
 // UTILS.CPP - Utility Functions Implementation
@@ -41,6 +47,45 @@ string trim(const string& str) {
     return str.substr(first, last - first + 1);
 }
 
+// ==================== ZERO-COPY TOKENIZER ====================
+
+// Split a line into field views
+// What it does: Walks the line once with memchr-style find(), recording where each
+// field starts and ends. The views point into 'line', so they are only valid while
+// the line buffer is alive and unchanged.
+// Example: "john|Tech Fest|11-11-2025 14:30" → ["john", "Tech Fest", "11-11-2025 14:30"]
+size_t splitFields(string_view line, char delimiter, string_view* fields, size_t maxFields) {
+    size_t count = 0;
+    size_t start = 0;
+    while (true) {
+        size_t end = line.find(delimiter, start);
+        string_view field = line.substr(start, end == string_view::npos ? string_view::npos : end - start);
+        if (count < maxFields) fields[count] = field;
+        count++;
+        if (end == string_view::npos) break;
+        start = end + 1;
+    }
+    return count;
+}
+
+// Trim whitespace from a view
+// What it does: Same as trim(), but only moves the view's start/end (no substr copy)
+string_view trimView(string_view str) {
+    size_t first = str.find_first_not_of(" \t\n\r");
+    if (first == string_view::npos) return string_view();
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return str.substr(first, last - first + 1);
+}
+
+// Parse an integer from a view
+// What it does: Uses from_chars, which reads digits in place (stoi needs a std::string)
+bool parseInt(string_view str, int& value) {
+    str = trimView(str);
+    if (str.empty()) return false;
+    auto result = from_chars(str.data(), str.data() + str.size(), value);
+    return result.ec == errc() && result.ptr == str.data() + str.size();
+}
+
 // Check if string contains only digits
 // What it does: Validates if a string contains only numbers (0-9)
 // Example: "123" → true, "12a3" → false
@@ -58,38 +103,16 @@ bool isNumeric(const string& str) {
 
 // Validate date format (DD-MM-YYYY)
 // What it does: Checks if a date string follows the correct format and has valid values
-// Example: "15-03-2025" → true, "32-13-2020" → false
+// Example: "15-03-2025" → true, "32-13-2020" → false, "31-02-2026" → false
 // Why needed: Ensures users enter dates in the correct format when creating/editing events
 bool isValidDate(const string& date) {
-    // Check if length is exactly 10 characters (DD-MM-YYYY)
-    if (date.length() != 10) return false;
-    
-    // Check if hyphens are in the correct positions
-    if (date[2] != '-' || date[5] != '-') return false;
-    
-    // Extract day, month, and year as substrings
-    string day = date.substr(0, 2);      // Characters 0-1
-    string month = date.substr(3, 2);    // Characters 3-4
-    string year = date.substr(6, 4);     // Characters 6-9
-    
-    // Check if all components are numeric
-    if (!isNumeric(day) || !isNumeric(month) || !isNumeric(year)) return false;
-    
-    // Convert strings to integers for range validation
-    int d = stoi(day);       // stoi = "string to integer"
-    int m = stoi(month);
-    int y = stoi(year);
-    
-    // Validate month range (1-12)
-    if (m < 1 || m > 12) return false;
-    
-    // Validate day range (1-31) - simplified, doesn't check month-specific days
-    if (d < 1 || d > 31) return false;
+    // parseDate() checks the DD-MM-YYYY layout, the digits and the calendar
+    // (month-specific days and leap years) without allocating
+    uint32_t packed = parseDate(date);
+    if (packed == 0) return false;
     
     // Validate year (must be 2025 or later)
-    if (y < 2025) return false;
-    
-    return true;    // All validations passed
+    return (packed >> 9) >= 2025;
 }
 
 // Convert string to lowercase
@@ -105,3 +128,159 @@ string toLower(const string& str) {
     
     return result;          // Return the lowercase version
 }
+
+// ==================== PACKED TIMESTAMPS ====================
+
+// Pack "DD-MM-YYYY" into one 32-bit integer (see parseDate() in dateparse.h)
+// Used by: the binary snapshot's fixed-width date column
+uint32_t packDate(string_view date) {
+    return parseDate(date);
+}
+
+// Format a packed date as "DD-MM-YYYY"
+string formatDate(uint32_t packed) {
+    if (packed == 0) return "";
+
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%02u-%02u-%04u",
+             packed & 0x1F, (packed >> 5) & 0xF, packed >> 9);
+    return string(buffer);
+}
+
+// Day number of "DD-MM-YYYY"
+// Used by: Event (parsed once when the event is created or loaded) and the date index
+int32_t dayNumber(string_view date) {
+    uint32_t packed = packDate(date);
+    if (packed == 0) return INVALID_DAY;
+    return daysFromCivil(packed >> 9, (packed >> 5) & 0xF, packed & 0x1F);
+}
+
+// Day number -> "DD-MM-YYYY" (the inverse of daysFromCivil() in dateparse.h)
+string formatDayNumber(int32_t day) {
+    int z = day + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int dayOfEra = z - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int mp = (5 * dayOfYear + 2) / 153;
+    int d = dayOfYear - (153 * mp + 2) / 5 + 1;
+    int m = mp < 10 ? mp + 3 : mp - 9;
+    int y = yearOfEra + era * 400 + (m <= 2);
+
+    char buffer[40];    // Room for any int, so the compiler sees no truncation
+    snprintf(buffer, sizeof(buffer), "%02d-%02d-%04d", d, m, y);
+    return string(buffer);
+}
+
+// Today's day number
+int32_t todayDayNumber() {
+    return (int32_t)(currentTimestamp() / 1440);
+}
+
+// Parse "DD-MM-YYYY HH:MM" into a timestamp (see parseDateTime() in dateparse.h)
+// Used by: Registration, so each record stores 4 bytes instead of a 16-char string
+static_assert(INVALID_TIMESTAMP == INVALID_DATETIME, "one 'no time' value");
+
+Timestamp parseTimestamp(string_view dateTime) {
+    return parseDateTime(dateTime);
+}
+
+// Format a timestamp as "DD-MM-YYYY HH:MM"
+// What it does: Splits off the day number (formatted like an event date) and the
+// minutes within the day
+string formatTimestamp(Timestamp timestamp) {
+    if (timestamp == INVALID_TIMESTAMP) return "";
+
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), " %02u:%02u", (timestamp % 1440) / 60, timestamp % 60);
+    return formatDayNumber((int32_t)(timestamp / 1440)) + buffer;
+}
+
+// The current local time as a timestamp
+Timestamp currentTimestamp() {
+    time_t now = time(nullptr);
+    tm local;
+    localtime_r(&now, &local);
+    return (Timestamp)daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * 1440 +
+           local.tm_hour * 60 + local.tm_min;
+}
+
+// Current local date/time
+// localtime_r() fills our own struct instead of a shared static one
+string currentDateTime() {
+    time_t now = time(0);
+    tm timeinfo;
+    localtime_r(&now, &timeinfo);
+    char buffer[20];
+    strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M", &timeinfo);
+    return string(buffer);
+}
+
+// ==================== FILE STAMPS ====================
+
+// Default stamp describes a missing file
+FileStamp::FileStamp()
+    : exists(false), device(0), inode(0), size(0), modifiedSec(0), modifiedNsec(0) {}
+
+// Two stamps are equal when they describe the same file with the same contents version
+// Inode catches files replaced by rename, size/mtime catch in-place edits
+bool FileStamp::operator==(const FileStamp& other) const {
+    return exists == other.exists && device == other.device && inode == other.inode &&
+           size == other.size && modifiedSec == other.modifiedSec &&
+           modifiedNsec == other.modifiedNsec;
+}
+
+bool FileStamp::operator!=(const FileStamp& other) const {
+    return !(*this == other);
+}
+
+// Read the current stamp of a file
+// What it does: Calls stat() and copies out the fields we care about
+// Used by: EventStore to decide whether a data file must be re-read
+FileStamp getFileStamp(const string& path) {
+    FileStamp stamp;
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return stamp;    // File missing - exists stays false
+    }
+    stamp.exists = true;
+    stamp.device = info.st_dev;
+    stamp.inode = info.st_ino;
+    stamp.size = info.st_size;
+    stamp.modifiedSec = info.st_mtim.tv_sec;
+    stamp.modifiedNsec = info.st_mtim.tv_nsec;
+    return stamp;
+}
+
+// ==================== DURABLE FILE REPLACEMENT ====================
+
+// Flush a file to disk
+// An ofstream cannot fsync, so the finished file is reopened and flushed by path
+bool syncFile(const string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+// Flush the directory entry changes (renames, new files) of a file's folder
+bool syncParentDirectory(const string& path) {
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+// Replace a file atomically and durably
+// What it does: temp file to disk -> rename over the target -> directory to disk.
+// rename() is atomic, so readers (and a restart after a crash) see either version
+// in full, never a truncated or half-written file
+bool replaceFileDurably(const string& tempPath, const string& path) {
+    if (!syncFile(tempPath)) return false;
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) return false;
+    return syncParentDirectory(path);
+}
@@ -0,0 +1,40 @@
+#include "verifierpool.h"
+#include "password.h"
+#include <memory>
+
+// ========================================
+// VERIFIERPOOL.CPP - Password Verifier Pool Implementation
+// ========================================
+// This file implements VerifierPool, which keeps slow password hashing off the
+// login path by running it on a bounded WorkerPool.
+
+VerifierPool::VerifierPool(size_t threadCount, size_t maxQueued)
+    : workers(threadCount, maxQueued) {}
+
+VerifierPool& VerifierPool::instance() {
+    static VerifierPool pool;
+    return pool;
+}
+
+// packaged_task is move-only and function<> must be copyable, so it is shared
+future<bool> VerifierPool::verify(const string& stored, const string& password) {
+    auto task = make_shared<packaged_task<bool()>>([stored, password] {
+        return verifyPassword(stored, password);
+    });
+    future<bool> result = task->get_future();
+    workers.submit([task] { (*task)(); });
+    return result;
+}
+
+future<string> VerifierPool::hash(const string& password) {
+    auto task = make_shared<packaged_task<string()>>([password] {
+        return hashPassword(password);
+    });
+    future<string> result = task->get_future();
+    workers.submit([task] { (*task)(); });
+    return result;
+}
+
+size_t VerifierPool::threadCount() const {
+    return workers.threadCount();
+}
@@ -0,0 +1,75 @@
+#include "workerpool.h"
+
+// ========================================
+// WORKERPOOL.CPP - Worker Thread Pool Implementation
+// ========================================
+// This file implements WorkerPool: a bounded work queue drained by a fixed
+// number of threads.
+
+// Constructor
+// What it does: Starts the workers; each one waits for tasks on the queue
+WorkerPool::WorkerPool(size_t threadCount, size_t maxQueued)
+    : queueLimit(maxQueued > 0 ? maxQueued : 1), runningTasks(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 2;
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+// Destructor - let the workers drain the queue, then join them
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Worker: take the oldest task, run it outside the lock, repeat
+void WorkerPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock);
+            taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;    // Stopping and nothing left to do
+            task = move(tasks.front());
+            tasks.pop_front();
+            runningTasks++;
+        }
+        slotFree.notify_one();
+        task();
+
+        {
+            lock_guard<mutex> guard(lock);
+            runningTasks--;
+            if (runningTasks == 0 && tasks.empty()) idle.notify_all();
+        }
+    }
+}
+
+// Queue a task, waiting while the queue is full
+void WorkerPool::submit(function<void()> task) {
+    {
+        unique_lock<mutex> guard(lock);
+        slotFree.wait(guard, [this] { return tasks.size() < queueLimit; });
+        tasks.push_back(move(task));
+    }
+    taskReady.notify_one();
+}
+
+// Wait for the queue to drain and the last running task to finish
+void WorkerPool::wait() {
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this] { return tasks.empty() && runningTasks == 0; });
+}
+
+size_t WorkerPool::threadCount() const {
+    return workers.size();
+}